@@ -0,0 +1,41 @@
+#!/bin/sh
+# Builds a profile-guided, link-time optimized hangman binary.
+#
+# Step 1 compiles an instrumented binary, step 2 trains it by replaying
+# pgo/transcript.txt at every difficulty and by running a tournament with the
+# example strategy, step 3 rebuilds hangman.c with the collected profile.
+# Run from the repository root so words.txt is found.
+# Both builds use the same output name so gcc finds the profile data.
+set -e
+
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:-"-O2 -Wall"}
+PROFILE_DIR=pgo/profile
+TRAINING_RUNS=${TRAINING_RUNS:-10}
+
+rm -rf "$PROFILE_DIR"
+mkdir -p "$PROFILE_DIR"
+
+echo "[1/3] Building instrumented binary..."
+$CC $CFLAGS -fprofile-generate -fprofile-dir="$PROFILE_DIR" \
+  -pthread -o hangman hangman.c -ldl
+
+echo "[2/3] Training on pgo/transcript.txt and a tournament..."
+$CC $CFLAGS -shared -fPIC -pthread -o pgo/frequency.so strategies/frequency.c
+./hangman --tournament pgo/frequency.so >/dev/null
+run=0
+while [ "$run" -lt "$TRAINING_RUNS" ]; do
+  for difficulty in 1 2 3 7; do
+    { echo "$difficulty"; cat pgo/transcript.txt; } |
+      ./hangman --seed "$run" >/dev/null 2>&1
+  done
+  run=$((run + 1))
+done
+
+echo "[3/3] Building optimized binary..."
+$CC $CFLAGS -flto -fprofile-use -fprofile-correction \
+  -fprofile-dir="$PROFILE_DIR" -pthread -o hangman hangman.c -ldl
+
+rm -f pgo/frequency.so
+
+echo "Done: ./hangman"
@@ -1,33 +1,385 @@
 #include <ctype.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 #include <time.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "hangman_strategy.h"
+#include "packed_word.h"
 
 #define MAX_WORD_LENGTH 100
 #define INPUT_BUFFER_SIZE 10
 #define ALPHABET_SIZE 26
 #define SCREEN_CLEAR_LINES 50
+#define DECOMPRESS_CHUNK_SIZE 65536
+// Bytes classified at once by the loader's line scanner
+#define SCAN_BLOCK_SIZE 32
+// Line records produced per scanLines call
+#define LINE_BATCH_SIZE 256
+// Used to size the word list up front from the file size
+#define ESTIMATED_BYTES_PER_WORD 8
+#define MAX_ESTIMATED_WORDS (1 << 26)
+// Frequency of a word whose line has no frequency column
+#define DEFAULT_WORD_FREQUENCY 1
+// FNV-1a, for the word set used when merging dictionaries
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
 #define DEFAULT_DIFFICULTY_CHOICE 2
 // Difficulty settings
 #define EASY_GUESSES 8
 #define MEDIUM_GUESSES 6 // Default
 #define HARD_GUESSES 4
+#define DIFFICULTY_COUNT 3
+// Games claimed at once by a tournament thread
+#define TOURNAMENT_CHUNK_SIZE 64
+// Philox4x32-10 constants (Salmon et al., "Parallel Random Numbers: As Easy as
+// 1, 2, 3")
+#define PHILOX_ROUNDS 10
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+// Letter mask of a word that has characters outside a-z
+#define NOT_SPELLABLE UINT32_MAX
+#define BONUS_WORDS_PER_LINE 8
+// Word lists this long build the subset index on several threads
+#define PARALLEL_INDEX_THRESHOLD 65536
+#define MAX_INDEX_THREADS 8
+// The parallel build splits the trie on the first letter bits of each mask
+#define SUBSET_PARTITION_BITS 4
+#define SUBSET_PARTITIONS (1 << SUBSET_PARTITION_BITS)
+// LazyIndex states
+#define LAZY_INDEX_IDLE 0
+#define LAZY_INDEX_BUILDING 1
+#define LAZY_INDEX_READY 2
+#define LAZY_INDEX_FAILED 3
+#define TIME_ATTACK_SECONDS 60
+#define ROUND_ARENA_SIZE 4096 // Grows to the largest round seen
+#define ROUND_ARENA_ALIGNMENT 16
+// Whole-word guesses; a guess line holds a word, a newline and the terminator
+#define GUESS_BUFFER_SIZE (MAX_WORD_LENGTH + 2)
+#define MAX_SUGGESTION_DISTANCE 2
+#define MAX_SUGGESTIONS 5
+#define WORD_GUESS_CORRECT 0
+#define WORD_GUESS_WRONG 1
+#define WORD_GUESS_UNKNOWN 2
+// Anagram signatures: a 4-bit count per letter, 16 letters per 64-bit word
+#define ANAGRAM_COUNT_BITS 4
+#define ANAGRAM_MAX_COUNT 15
+#define ANAGRAM_LETTERS_PER_WORD 16
+
+/**
+ * @brief One node of the subset index trie. Level n branches on letter n.
+ */
+typedef struct {
+  int child[2];  // Child for letter absent/present, 0 if none
+  int firstWord; // At depth 26: first word with this letter set, or -1
+} SubsetIndexNode;
+
+/**
+ * @brief Answers "which words use only letters from this set" without
+ * scanning the word list.
+ */
+typedef struct {
+  SubsetIndexNode *nodes;
+  int nodeCount;
+  int nodeCapacity;
+  int *nextWord; // Word id -> next word id with the same letter set, or -1
+  int wordCapacity;
+} SubsetIndex;
+
+/**
+ * @brief State shared by the threads of a parallel subset index build.
+ */
+typedef struct {
+  char **wordList;
+  int wordCount;
+  uint32_t *masks; // Stage 1 output: letterMask of every word
+  int *nextWord;   // The index's chain array, shared by all partitions
+  SubsetIndex partitions[SUBSET_PARTITIONS]; // Stage 2 output
+  int threadCount;
+  int failed; // Set by any thread whose allocation failed
+} SubsetIndexBuild;
+
+/**
+ * @brief An index built on a background thread the first time a feature
+ * needs it. Callers either wait for it or use a slower path meanwhile.
+ */
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t finished; // Signalled when state leaves LAZY_INDEX_BUILDING
+  int state;               // One of the LAZY_INDEX_* values
+  pthread_t thread;
+  int hasThread;
+  char **words;  // Snapshot of the word list while building
+  int wordCount; // Words covered by the index
+  void *index;   // The built index once state is LAZY_INDEX_READY
+  void *(*build)(char **wordList, int wordCount);
+  void (*destroy)(void *index);
+} LazyIndex;
+
+typedef struct {
+  SubsetIndexBuild *build;
+  int thread;
+  void (*stage)(SubsetIndexBuild *, int);
+} SubsetIndexTask;
+
+/**
+ * @brief The ids of the dictionary words of one length.
+ */
+typedef struct {
+  int *wordIds;
+  int count;
+  int capacity;
+} LengthBucket;
+
+/**
+ * @brief Dictionary words grouped by length, for finding the words within a
+ * few edits of a misspelled guess.
+ */
+typedef struct {
+  LengthBucket buckets[MAX_WORD_LENGTH]; // Indexed by word length
+} SpellIndex;
+
+/**
+ * @brief A dictionary word close to a guess.
+ */
+typedef struct {
+  int wordId;
+  int distance;
+} Suggestion;
+
+/**
+ * @brief The letter counts of a word, packed (see anagramSignature).
+ */
+typedef struct {
+  uint64_t packed[2];
+} AnagramSignature;
+
+/**
+ * @brief The dictionary words with one anagram signature.
+ */
+typedef struct {
+  AnagramSignature signature;
+  int firstWord; // First word id of the chain, or -1 for an empty slot
+  int wordCount; // Distinct words in the chain
+} AnagramGroup;
+
+/**
+ * @brief A hash table from anagram signature to the words that have it.
+ */
+typedef struct {
+  AnagramGroup *slots; // Open addressing
+  int capacity;        // A power of two
+  int groupCount;
+  int *nextWord;    // Word id -> next word id in the same group, or -1
+  int wordCapacity; // Slots allocated in nextWord
+  int wordCount;    // Words of the word list added so far
+} AnagramIndex;
+
+/**
+ * @brief One line found by scanLines.
+ */
+typedef struct {
+  size_t offset; // Start of the line in the buffer
+  size_t length; // Length without the newline and any trailing '\r'
+  int valid;     // 1 if the line holds only letters
+} LineRecord;
+
+/**
+ * @brief Counts of the lines appendWords skipped, reported once per file by
+ * reportSkippedLines.
+ */
+typedef struct {
+  int invalid; // Lines with characters other than letters
+  int tooLong; // Words of MAX_WORD_LENGTH characters or more
+} SkippedLines;
+
+/**
+ * @brief Corpus frequencies of the words in a word list, by word id.
+ */
+typedef struct {
+  uint32_t *counts;
+  int capacity; // Slots allocated in counts
+} WordFrequencies;
+
+/**
+ * @brief Progress of scanLines through a buffer.
+ */
+typedef struct {
+  const char *data;
+  size_t size;
+  size_t position;  // Start of the next block to classify
+  size_t lineStart; // Start of the current line
+  int invalidCount; // Non-letters seen so far in the current line
+} LineScanner;
+
+/**
+ * @brief A hash set of words, stored as ids into a word list.
+ */
+typedef struct {
+  int *slots;    // Word ids, or -1 for an empty slot
+  int capacity;  // A power of two
+  int wordCount; // Words of the list already checked against the set
+} WordSet;
+
+/**
+ * @brief A word file being followed as it grows (like tail -f).
+ */
+typedef struct {
+  const char *filename;
+  size_t offset; // Bytes of the file already loaded
+  int capacity;  // Slots allocated in the word list
+} WordFollower;
+
+/**
+ * @brief A bump allocator for memory that lives for one round of the game.
+ */
+typedef struct {
+  char *base;
+  size_t size;      // Bytes at base
+  size_t used;      // Bytes handed out from base this round
+  size_t requested; // Bytes handed out this round, including overflow
+  char *overflow;   // Blocks for allocations that did not fit, linked
+} RoundArena;
+
+/**
+ * @brief Everything a time-attack round needs, prepared before it starts.
+ */
+typedef struct {
+  const char *secretWord;
+  uint32_t secretMask; // letterMask(secretWord), for one-step hit tests
+  char displayWord[MAX_WORD_LENGTH];
+  int hiddenLetters;
+} TimeAttackRound;
 
 char **loadWords(const char *filename, int *wordCount);
+char **loadWeightedWords(const char *filename, int *wordCount,
+                         WordFrequencies *frequencies);
+void classifyBlock(const char *p, size_t n, uint32_t *newlines,
+                   uint32_t *invalid);
+int scanLines(LineScanner *scanner, LineRecord *records, int maxRecords);
+void emitLine(LineScanner *scanner, size_t end, LineRecord *record);
+void copyLowercase(char *dest, const char *src, size_t len);
+void freeWordRange(char **wordList, int first, int last);
+int parseFrequencyLine(const char *line, size_t length, size_t *wordLength,
+                       uint32_t *frequency);
+int appendWords(const char *data, size_t size, char ***wordList, int *capacity,
+                int wordCount, WordFrequencies *frequencies,
+                SkippedLines *skipped);
+void reportSkippedLines(const SkippedLines *skipped);
+int reserveWords(char ***wordList, int *capacity, int needed);
+const char *decompressorFor(const char *data, size_t size);
+char **loadCompressedWords(const char *filename, const char *decompressor,
+                           int *wordCount, WordFrequencies *frequencies);
+int followWords(WordFollower *follower, char ***wordList, int *wordCount);
 void freeWordList(char **wordList, int wordCount);
+uint32_t hashWord(const char *word);
+int *findWordSlot(const WordSet *set, char **wordList, const char *word);
+int reserveWordSet(WordSet *set, char **wordList, int wordCount);
+int dropKnownWords(WordSet *set, char **wordList, int *wordCount);
+int mergeWords(WordSet *set, char ***wordList, int *wordCount, char **extra,
+               int extraCount);
 void clearScreen();
 void pauseForUser();
 void consumeRemainingInput();
 void drawHangman(int incorrectGuesses);
+int initRoundArena(RoundArena *arena, size_t size);
+void *roundArenaAlloc(RoundArena *arena, size_t bytes);
+void resetRoundArena(RoundArena *arena);
+void freeRoundArena(RoundArena *arena);
+uint64_t gameRandom(uint64_t seed, uint64_t gameIndex);
+int revealLetter(const char *secretWord, char *displayWord, char guess);
+int revealPackedLetter(uint64_t packedSecret, char *displayWord, char guess);
+uint32_t letterMask(const char *word);
+int initSubsetIndex(SubsetIndex *index);
+int reserveSubsetNodes(SubsetIndex *index, int count);
+int descendSubsetIndex(SubsetIndex *index, int node, uint32_t mask,
+                       int fromBit, int toBit);
+int insertSubsetMask(SubsetIndex *index, int wordId, uint32_t mask,
+                     int firstBit);
+int addToSubsetIndex(SubsetIndex *index, int wordId, const char *word);
+void computeMasksStage(SubsetIndexBuild *build, int thread);
+void buildPartitionsStage(SubsetIndexBuild *build, int thread);
+void *subsetIndexWorker(void *arg);
+void runSubsetIndexStage(SubsetIndexBuild *build,
+                         void (*stage)(SubsetIndexBuild *, int));
+int attachPartition(SubsetIndex *index, const SubsetIndex *partition, int p);
+int buildSubsetIndex(SubsetIndex *index, char **wordList, int wordCount);
+void freeSubsetIndex(SubsetIndex *index);
+int findSubsetWords(const SubsetIndex *index, uint32_t mask, int *wordIds);
+void lazyIndexInit(LazyIndex *lazy, void *(*build)(char **, int),
+                   void (*destroy)(void *));
+void *lazyIndexWorker(void *arg);
+void lazyIndexStart(LazyIndex *lazy, char **wordList, int wordCount);
+void *lazyIndexGet(LazyIndex *lazy, int wait);
+void lazyIndexFree(LazyIndex *lazy);
+void *buildSubsetIndexLazily(char **wordList, int wordCount);
+void destroySubsetIndex(void *index);
+int scanSubsetWords(char **wordList, int wordCount, uint32_t mask,
+                    int *wordIds);
+int editDistance(const char *a, const char *b, int bound);
+int myersDistance(const uint64_t positions[ALPHABET_SIZE], int patternLength,
+                  const char *word, int wordLength, int bound);
+int addToSpellIndex(SpellIndex *index, int wordId, const char *word);
+void *buildSpellIndexLazily(char **wordList, int wordCount);
+void destroySpellIndex(void *index);
+void addSuggestion(Suggestion *matches, int *matchCount, Suggestion match);
+int findSuggestions(const SpellIndex *index, char **wordList,
+                    const char *guess, int maxDistance, Suggestion *matches);
+int checkWordGuess(LazyIndex *spellIndex, char **wordList, int wordCount,
+                   const char *secretWord, const char *guess);
+void printBonusWords(LazyIndex *lazyIndex, char **wordList, int wordCount,
+                     const char *guessedLetters, RoundArena *arena);
+int anagramSignature(const char *word, AnagramSignature *signature);
+uint32_t hashSignature(const AnagramSignature *signature);
+AnagramGroup *findAnagramGroup(const AnagramIndex *index,
+                               const AnagramSignature *signature);
+int resizeAnagramIndex(AnagramIndex *index, int capacity);
+int addToAnagramIndex(AnagramIndex *index, char **wordList);
+int buildAnagramIndex(AnagramIndex *index, char **wordList, int wordCount);
+void freeAnagramIndex(AnagramIndex *index);
+void playAnagramRound(const AnagramIndex *index, char **wordList,
+                      const char *secretWord, RoundArena *arena);
+int playStrategyGame(const HangmanStrategy *strategy, char **wordList,
+                     const uint32_t *frequencies, int wordCount,
+                     const char *secretWord, int maxIncorrectGuesses,
+                     int maxThreads, int *incorrectGuessesOut);
+int runTournament(char **wordList, const uint32_t *frequencies, int wordCount,
+                  char **strategyPaths, int strategyCount);
+void prepareTimeAttackRound(TimeAttackRound *round, char **wordList,
+                            int wordCount, uint64_t seed, uint64_t gameIndex);
+long millisecondsUntil(const struct timespec *deadline);
+int playTimeAttack(char **wordList, int wordCount, uint64_t seed);
 /**
  * @brief Loads words from a specified file into a dynamically allocated array
  * of strings.
  *
- * Opens the file, counts the words, allocates memory for the word list (array
- * of char*) and for each individual word (char*), reads words line by line,
- * stores them, and returns the list. Also updates the word count via the output
- * parameter.
+ * Maps the file into memory and asks the kernel for sequential readahead, so
+ * the file is read once and never copied through a stdio buffer. The word
+ * list is sized from the file size, then a single pass (appendWords) finds
+ * the lines with scanLines and stores each word (char*) in the list, growing
+ * it with reserveWords if the estimate was short. Words are lowercased and
+ * CRLF line endings accepted; lines that are not plain words are skipped, and
+ * a frequency column after a word is ignored (see loadWeightedWords). Files
+ * compressed with gzip or zstd are recognized by their first bytes and
+ * streamed through loadCompressedWords instead. Also updates the word count
+ * via the output parameter.
+ *
+ * The mapping is only used while loading: every word is copied into its own
+ * allocation, so the whole list must fit in memory.
  *
  * @param filename The path to the file containing words (one word per line).
  * @param wordCount A pointer to an integer where the number of loaded words
@@ -35,17 +387,29 @@ void drawHangman(int incorrectGuesses);
  * @return A pointer to the dynamically allocated array of word strings
  * (char**), or NULL if an error occurs (e.g., file not found, memory allocation
  * failed). The caller is responsible for freeing the allocated memory using
- * freeWordList (which we will define later).
+ * freeWordList.
  */
 char **loadWords(const char *filename, int *wordCount) {
+  return loadWeightedWords(filename, wordCount, NULL);
+}
+
+/**
+ * @brief Loads words like loadWords, and also their corpus frequencies.
+ *
+ * A line may follow its word with spaces or tabs and a decimal count, e.g.
+ * "the\t5021". Words without a count get DEFAULT_WORD_FREQUENCY, so a plain
+ * word file gives every word the same weight.
+ *
+ * @param frequencies Filled with one count per loaded word, or NULL to
+ * ignore the counts. The caller frees frequencies->counts.
+ */
+char **loadWeightedWords(const char *filename, int *wordCount,
+                         WordFrequencies *frequencies) {
   *wordCount = 0;
-  FILE *file = NULL;
-  file = fopen(filename, "r");
   char **wordList = NULL;
-  int i = 0;
-  char *currentWord = NULL;
 
-  if (file == NULL) {
+  int fd = open(filename, O_RDONLY);
+  if (fd == -1) {
 
     fprintf(stderr, "Could not open the word file: %s\n", filename);
     fprintf(stderr, "Please ensure the file exists in the same directory as "
@@ -54,126 +418,1742 @@ char **loadWords(const char *filename, int *wordCount) {
     return NULL;
   }
 
-  int lineCount = 0;
-  char lineBuffer[MAX_WORD_LENGTH];
-
-  while (fgets(lineBuffer, MAX_WORD_LENGTH, file) != NULL) {
-    lineCount++;
+  struct stat fileInfo;
+  if (fstat(fd, &fileInfo) == -1) {
+    perror("Error reading file size");
+    close(fd);
+    return NULL;
   }
 
-  if (ferror(file)) {
-    perror("Error reading file during word count");
-    fprintf(stderr, "An error occurred while trying to count words in '%s'.\n",
+  size_t fileSize = (size_t)fileInfo.st_size;
+  if (fileSize == 0) {
+    fprintf(stderr,
+            "Warning: Word file '%s' is empty or contains no valid lines.\n",
             filename);
-    fclose(file);
+    close(fd);
     return NULL;
   }
 
-  if (lineCount == 0) {
-    fprintf(stderr,
-            "Warning: Word file '%s' is empty or contains no valid lines.\n",
+  const char *data = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // The mapping stays valid after the descriptor is closed
+  if (data == MAP_FAILED) {
+    perror("Error mapping word file");
+    fprintf(stderr, "An error occurred while trying to read '%s'.\n",
             filename);
-    fclose(file);
-    // We can return NULL or an empty list. Returning NULL is simpler for now.
-    // *wordCount is already 0.
     return NULL;
   }
-  rewind(file);
+  madvise((void *)data, fileSize, MADV_SEQUENTIAL);
 
-  size_t listSize = lineCount * sizeof(char *);
-  wordList = (char **)malloc(listSize);
-  if (wordList == NULL) {
-    perror("Memory allocation failed for word list");
-    fprintf(stderr, "Error: Could not allocate memory to store %d words.\n",
-            lineCount);
-    fclose(file);
+  const char *decompressor = decompressorFor(data, fileSize);
+  if (decompressor != NULL) {
+    munmap((void *)data, fileSize);
+    return loadCompressedWords(filename, decompressor, wordCount,
+                               frequencies);
+  }
+
+  // Size the list from the file size so it rarely has to grow while loading
+  size_t estimate = fileSize / ESTIMATED_BYTES_PER_WORD + 1;
+  int capacity = 0;
+  if (!reserveWords(&wordList, &capacity,
+                    estimate < MAX_ESTIMATED_WORDS ? (int)estimate
+                                                   : MAX_ESTIMATED_WORDS)) {
+    munmap((void *)data, fileSize);
+    return NULL;
+  }
+  SkippedLines skipped = {0, 0};
+  int loaded = appendWords(data, fileSize, &wordList, &capacity, 0,
+                           frequencies, &skipped);
+  reportSkippedLines(&skipped);
+  if (munmap((void *)data, fileSize) == -1) {
+    perror("Warning: Error unmapping word file");
+  }
+  if (loaded == -1) {
+    free(wordList);
     return NULL;
   }
-  for (int k = 0; k < lineCount; ++k) {
-    wordList[k] = NULL;
+  if (loaded == 0) {
+    fprintf(stderr, "Warning: Word file '%s' contains no valid words.\n",
+            filename);
   }
-  i = 0;
+  *wordCount = loaded;
 
-  while (fgets(lineBuffer, MAX_WORD_LENGTH, file) != NULL) {
-    if (i >= lineCount) {
-      fprintf(stderr,
-              "Warning: Read more lines than initially counted. Stopping at %d "
-              "lines.\n",
-              lineCount);
-      break;
+  return wordList;
+}
+
+/**
+ * @brief Classifies up to SCAN_BLOCK_SIZE bytes at once.
+ *
+ * Bit i of *newlines is set if p[i] is '\n'; bit i of *invalid is set if p[i]
+ * is neither a newline nor a letter (either case). With SSE2 a full block is
+ * two 16-byte compares per class; shorter blocks use the scalar loop.
+ */
+void classifyBlock(const char *p, size_t n, uint32_t *newlines,
+                   uint32_t *invalid) {
+#ifdef __SSE2__
+  if (n == SCAN_BLOCK_SIZE) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i letterA = _mm_set1_epi8('a');
+    const __m128i lastOffset = _mm_set1_epi8('z' - 'a');
+    uint32_t masks[2][2];
+    for (int half = 0; half < 2; half++) {
+      __m128i bytes = _mm_loadu_si128((const __m128i *)(p + 16 * half));
+      __m128i isNewline = _mm_cmpeq_epi8(bytes, newline);
+      // Letters are those whose lowercase form minus 'a' is at most 25
+      __m128i offset =
+          _mm_sub_epi8(_mm_or_si128(bytes, caseBit), letterA);
+      __m128i isLetter =
+          _mm_cmpeq_epi8(_mm_min_epu8(offset, lastOffset), offset);
+      masks[half][0] = (uint32_t)_mm_movemask_epi8(isNewline);
+      masks[half][1] =
+          ~(uint32_t)_mm_movemask_epi8(_mm_or_si128(isNewline, isLetter)) &
+          0xFFFF;
+    }
+    *newlines = masks[0][0] | masks[1][0] << 16;
+    *invalid = masks[0][1] | masks[1][1] << 16;
+    return;
+  }
+#endif
+  *newlines = 0;
+  *invalid = 0;
+  for (size_t i = 0; i < n; i++) {
+    char lower = p[i] | 0x20;
+    if (p[i] == '\n') {
+      *newlines |= 1u << i;
+    } else if (lower < 'a' || lower > 'z') {
+      *invalid |= 1u << i;
     }
-    size_t len = strlen(lineBuffer);
+  }
+}
+
+/**
+ * @brief Splits the next part of a buffer into line records, a block of
+ * SCAN_BLOCK_SIZE bytes at a time.
+ *
+ * A trailing '\r' is left out of the line's length; the line is valid when
+ * every other byte is a letter. Calls resume where the last one stopped, so a
+ * small records array can walk a buffer of any size.
+ *
+ * @param scanner The buffer and the position reached so far.
+ * @param records Receives the records.
+ * @param maxRecords The size of records.
+ * @return The number of records written; 0 once the buffer is done.
+ */
+int scanLines(LineScanner *scanner, LineRecord *records, int maxRecords) {
+  int count = 0;
 
-    if (len > 0 && lineBuffer[len - 1] == '\n') {
-      lineBuffer[len - 1] = '\0';
-      len = strlen(lineBuffer);
+  while (scanner->position < scanner->size && count < maxRecords) {
+    size_t base = scanner->position;
+    size_t n = scanner->size - base;
+    if (n > SCAN_BLOCK_SIZE) {
+      n = SCAN_BLOCK_SIZE;
     }
-    if (len == 0) {
-      continue;
+    uint32_t newlines, invalid;
+    classifyBlock(scanner->data + base, n, &newlines, &invalid);
+
+    // Skip what an earlier call already consumed from this block
+    uint32_t start = (uint32_t)(scanner->lineStart > base
+                                    ? scanner->lineStart - base
+                                    : 0);
+    uint32_t consumed = start == SCAN_BLOCK_SIZE ? 0 : ~0u << start;
+    newlines &= consumed;
+    invalid &= consumed;
+
+    while (newlines != 0 && count < maxRecords) {
+      uint32_t bit = __builtin_ctz(newlines);
+      uint32_t before = bit == 0 ? 0 : ~0u >> (SCAN_BLOCK_SIZE - bit);
+      scanner->invalidCount += __builtin_popcount(invalid & before);
+      invalid &= ~before;
+      emitLine(scanner, base + bit, &records[count++]);
+      newlines &= newlines - 1;
     }
+    if (newlines != 0) {
+      break; // Records are full; resume this block next call
+    }
+    scanner->invalidCount += __builtin_popcount(invalid);
+    scanner->position = base + n;
+  }
 
-    size_t wordMemorySize = len + 1;
-    currentWord = (char *)malloc(wordMemorySize);
+  if (scanner->position == scanner->size &&
+      scanner->lineStart < scanner->size && count < maxRecords) {
+    emitLine(scanner, scanner->size, &records[count++]); // No final newline
+  }
+  return count;
+}
 
-    if (currentWord == NULL) {
-      perror("Memory allocation failed for word string");
-      fprintf(stderr, "Error: Could not allocate memory for word #%d ('%s').\n",
-              i + 1, lineBuffer);
-      fprintf(stderr, "Cleaning up allocated memory before exiting...\n");
-      for (int j = 0; j < i; j++) {
-        if (wordList[j] != NULL) {
-          printf("DEBUG: Freeing previous word #%d at %p\n", j + 1,
-                 (void *)wordList[j]);
-          free(wordList[j]);
-        }
+/**
+ * @brief Records the line from the scanner's lineStart to end and starts the
+ * next one after it.
+ */
+void emitLine(LineScanner *scanner, size_t end, LineRecord *record) {
+  size_t length = end - scanner->lineStart;
+  int invalidCount = scanner->invalidCount;
+  if (length > 0 && scanner->data[end - 1] == '\r') {
+    length--;
+    invalidCount--;
+  }
+  record->offset = scanner->lineStart;
+  record->length = length;
+  record->valid = invalidCount == 0;
+  scanner->lineStart = end + 1;
+  scanner->invalidCount = 0;
+}
+
+/**
+ * @brief Copies len letters and a terminating '\0', lowercasing them eight at
+ * a time. Only valid for letters: setting bit 5 lowercases a letter.
+ */
+void copyLowercase(char *dest, const char *src, size_t len) {
+  size_t k = 0;
+  for (; k + sizeof(uint64_t) <= len; k += sizeof(uint64_t)) {
+    uint64_t chunk;
+    memcpy(&chunk, src + k, sizeof(chunk));
+    chunk |= 0x2020202020202020ull;
+    memcpy(dest + k, &chunk, sizeof(chunk));
+  }
+  for (; k < len; k++) {
+    dest[k] = src[k] | 0x20;
+  }
+  dest[len] = '\0';
+}
+
+/**
+ * @brief Frees the words from index first up to (not including) last.
+ */
+void freeWordRange(char **wordList, int first, int last) {
+  for (int j = first; j < last; j++) {
+    free(wordList[j]);
+    wordList[j] = NULL;
+  }
+}
+
+/**
+ * @brief Checks whether a line is a word followed by a frequency column:
+ * letters, then spaces or tabs, then decimal digits.
+ * @param wordLength Set to the length of the word part.
+ * @param frequency Set to the count, saturated at UINT32_MAX.
+ * @return 1 if the line has that form, 0 otherwise.
+ */
+int parseFrequencyLine(const char *line, size_t length, size_t *wordLength,
+                       uint32_t *frequency) {
+  size_t k = 0;
+  while (k < length && isalpha((unsigned char)line[k])) {
+    k++;
+  }
+  *wordLength = k;
+  if (k == 0 || k == length || (line[k] != ' ' && line[k] != '\t')) {
+    return 0;
+  }
+  while (k < length && (line[k] == ' ' || line[k] == '\t')) {
+    k++;
+  }
+  if (k == length) {
+    return 0;
+  }
+  uint64_t count = 0;
+  for (; k < length; k++) {
+    if (!isdigit((unsigned char)line[k])) {
+      return 0;
+    }
+    count = count * 10 + (line[k] - '0');
+    if (count > UINT32_MAX) {
+      count = UINT32_MAX;
+    }
+  }
+  *frequency = (uint32_t)count;
+  return 1;
+}
+
+/**
+ * @brief Copies each word of a buffer into its own lowercase string and
+ * appends it to a word list.
+ *
+ * Lines are found and checked by scanLines. Empty lines are ignored; lines
+ * with characters other than letters, or longer than MAX_WORD_LENGTH - 1
+ * characters, are skipped and counted in skipped, so a file read in chunks
+ * gets one warning (reportSkippedLines). A line that fails the check is kept
+ * if it is a word with a frequency column (parseFrequencyLine).
+ *
+ * @param data The buffer holding one word per line.
+ * @param size The size of the buffer in bytes.
+ * @param wordList The list to append to. Grown with reserveWords as needed.
+ * @param capacity The slots allocated in the list. Updated.
+ * @param wordCount The number of words already in the list.
+ * @param frequencies Receives each word's frequency, or NULL.
+ * @param skipped Counts of skipped lines. Updated.
+ * @return The new number of words, or -1 if memory allocation failed (the
+ * words appended by this call are freed; the earlier ones are kept).
+ */
+int appendWords(const char *data, size_t size, char ***wordList, int *capacity,
+                int wordCount, WordFrequencies *frequencies,
+                SkippedLines *skipped) {
+  LineScanner scanner = {data, size, 0, 0, 0};
+  LineRecord records[LINE_BATCH_SIZE];
+  int recordCount;
+  int i = wordCount;
+
+  while ((recordCount = scanLines(&scanner, records, LINE_BATCH_SIZE)) > 0) {
+    if (!reserveWords(wordList, capacity, i + recordCount)) {
+      freeWordRange(*wordList, wordCount, i);
+      return -1;
+    }
+    if (frequencies != NULL && frequencies->capacity < *capacity) {
+      uint32_t *grown =
+          realloc(frequencies->counts, *capacity * sizeof(uint32_t));
+      if (grown == NULL) {
+        perror("Memory allocation failed for word frequencies");
+        freeWordRange(*wordList, wordCount, i);
+        return -1;
       }
-      free(wordList);
-      fclose(file);
-      return NULL;
+      frequencies->counts = grown;
+      frequencies->capacity = *capacity;
+    }
+    for (int r = 0; r < recordCount; r++) {
+      size_t len = records[r].length;
+      const char *word = data + records[r].offset;
+      uint32_t frequency = DEFAULT_WORD_FREQUENCY;
+
+      if (len == 0) {
+        continue;
+      }
+      if (!records[r].valid &&
+          !parseFrequencyLine(word, len, &len, &frequency)) {
+        skipped->invalid++;
+        continue;
+      }
+      if (len >= MAX_WORD_LENGTH) {
+        skipped->tooLong++;
+        continue;
+      }
+
+      size_t wordMemorySize = len + 1;
+      char *currentWord = (char *)malloc(wordMemorySize);
+
+      if (currentWord == NULL) {
+        perror("Memory allocation failed for word string");
+        fprintf(stderr, "Error: Could not allocate memory for word #%d.\n",
+                i + 1);
+        freeWordRange(*wordList, wordCount, i);
+        return -1;
+      }
+
+      copyLowercase(currentWord, word, len);
+      (*wordList)[i] = currentWord;
+      if (frequencies != NULL) {
+        frequencies->counts[i] = frequency;
+      }
+
+      i++;
     }
+  }
+
+  return i;
+}
+
+/**
+ * @brief Prints one warning for each kind of line a load skipped.
+ */
+void reportSkippedLines(const SkippedLines *skipped) {
+  if (skipped->invalid > 0) {
+    fprintf(stderr, "Warning: Skipped %d lines with characters other than "
+                    "letters.\n",
+            skipped->invalid);
+  }
+  if (skipped->tooLong > 0) {
+    fprintf(stderr, "Warning: Skipped %d words longer than %d characters.\n",
+            skipped->tooLong, MAX_WORD_LENGTH - 1);
+  }
+}
 
-    strcpy(currentWord, lineBuffer);
-    wordList[i] = currentWord;
+/**
+ * @brief Makes room for at least needed words in a word list, doubling its
+ * capacity so that appending one chunk at a time stays linear overall.
+ * @param wordList The word list. May be reallocated.
+ * @param capacity The slots allocated in the list. Updated.
+ * @return 1 on success, 0 if memory allocation failed (the list is kept).
+ */
+int reserveWords(char ***wordList, int *capacity, int needed) {
+  if (needed <= *capacity) {
+    return 1;
+  }
+  int newCapacity = *capacity ? *capacity * 2 : needed;
+  while (newCapacity < needed) {
+    newCapacity *= 2;
+  }
+  char **grown = realloc(*wordList, newCapacity * sizeof(char *));
+  if (grown == NULL) {
+    perror("Memory allocation failed for word list");
+    return 0;
+  }
+  *wordList = grown;
+  *capacity = newCapacity;
+  return 1;
+}
+
+/**
+ * @brief Returns the decompressor for a compressed word file, judged by its
+ * first bytes, or NULL if the data is plain text.
+ */
+const char *decompressorFor(const char *data, size_t size) {
+  if (size >= 2 && memcmp(data, "\x1F\x8B", 2) == 0) {
+    return "gzip";
+  }
+  if (size >= 4 && memcmp(data, "\x28\xB5\x2F\xFD", 4) == 0) {
+    return "zstd";
+  }
+  return NULL;
+}
+
+/**
+ * @brief Loads a compressed word file, decompressing and parsing at the same
+ * time.
+ *
+ * The decompressor ("gzip" or "zstd", run with -dc) writes into a pipe from
+ * its own process while this one splits each chunk it reads into words. The
+ * pipe buffer bounds how far decompression can run ahead, and nothing is
+ * written to disk.
+ *
+ * @param filename The path to the compressed word file.
+ * @param decompressor The program that decompresses it.
+ * @param wordCount Receives the number of loaded words.
+ * @return The word list (free with freeWordList), or NULL if an error
+ * occurred.
+ */
+char **loadCompressedWords(const char *filename, const char *decompressor,
+                           int *wordCount, WordFrequencies *frequencies) {
+  *wordCount = 0;
+  int fds[2];
+  if (pipe(fds) == -1) {
+    perror("Error creating decompression pipe");
+    return NULL;
+  }
+
+  pid_t child = fork();
+  if (child == -1) {
+    perror("Error starting decompressor");
+    close(fds[0]);
+    close(fds[1]);
+    return NULL;
+  }
+  if (child == 0) {
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[0]);
+    close(fds[1]);
+    execlp(decompressor, decompressor, "-dc", "--", filename, (char *)NULL);
+    fprintf(stderr, "Could not run '%s' to read '%s'.\n", decompressor,
+            filename);
+    _exit(127);
+  }
+  close(fds[1]);
+
+  char **wordList = NULL;
+  int capacity = 0;
+  int count = 0;
+  int failed = 0;
+  SkippedLines skipped = {0, 0}; // Summed over all chunks
+  size_t bufferSize = DECOMPRESS_CHUNK_SIZE;
+  size_t pending = 0; // Bytes of an unfinished line kept from the last chunk
+  char *buffer = malloc(bufferSize);
+  if (buffer == NULL) {
+    perror("Memory allocation failed for decompression buffer");
+    failed = 1;
+  }
+
+  while (!failed) {
+    if (pending == bufferSize) { // One line fills the buffer; make room
+      char *grown = realloc(buffer, bufferSize * 2);
+      if (grown == NULL) {
+        perror("Memory allocation failed for decompression buffer");
+        failed = 1;
+        break;
+      }
+      buffer = grown;
+      bufferSize *= 2;
+    }
+    ssize_t n = read(fds[0], buffer + pending, bufferSize - pending);
+    if (n == -1) {
+      perror("Error reading decompressed words");
+      failed = 1;
+      break;
+    }
 
-    i++;
+    size_t filled = pending + n;
+    size_t complete = filled;
+    if (n > 0) { // At end of stream the last line needs no newline
+      while (complete > 0 && buffer[complete - 1] != '\n') {
+        complete--;
+      }
+    }
+    int newCount = appendWords(buffer, complete, &wordList, &capacity, count,
+                               frequencies, &skipped);
+    if (newCount == -1) {
+      failed = 1;
+      break;
+    }
+    count = newCount;
+    pending = filled - complete;
+    memmove(buffer, buffer + complete, pending);
+    if (n == 0) {
+      break;
+    }
   }
-  if (ferror(file)) {
-    perror("Error reading file during second pass");
-    fprintf(stderr, "An error occurred while reading words from '%s'.\n",
+  free(buffer);
+  close(fds[0]); // Stops the decompressor early if we gave up
+  reportSkippedLines(&skipped);
+
+  int status = 0;
+  waitpid(child, &status, 0);
+  if (!failed && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+    fprintf(stderr, "Error: '%s' could not decompress '%s'.\n", decompressor,
             filename);
-    fprintf(stderr, "DEBUG: Need to implement proper cleanup for partially "
-                    "loaded list on read error!\\n");
-    free(wordList); // Free the array of pointers
-    fclose(file);   // Close the file
-    return NULL;    // Signal failure
+    failed = 1;
+  }
+  if (failed) {
+    freeWordList(wordList, count);
+    return NULL;
+  }
+  *wordCount = count;
+  return wordList;
+}
+
+/**
+ * @brief Loads the words appended to the word file since the last call and
+ * adds them to the word list.
+ *
+ * Only complete lines are loaded; a line still being written waits for the
+ * next call. The list grows by doubling, so following a file costs time
+ * proportional to the new words only. The first call (offset 0) loads the
+ * whole file. Indexes pick up the new words when they are next used (see
+ * printBonusWords).
+ *
+ * @param follower Where to read from, and what was already loaded.
+ * @param wordList The word list. May be reallocated.
+ * @param wordCount The number of words in the list. Updated.
+ * @return The number of words added, or -1 if an error occurred (the list
+ * keeps every word added before the error).
+ */
+int followWords(WordFollower *follower, char ***wordList, int *wordCount) {
+  int fd = open(follower->filename, O_RDONLY);
+  if (fd == -1) {
+    perror("Error opening followed word file");
+    return -1;
+  }
+  struct stat fileInfo;
+  if (fstat(fd, &fileInfo) == -1) {
+    perror("Error reading followed word file size");
+    close(fd);
+    return -1;
+  }
+
+  size_t fileSize = (size_t)fileInfo.st_size;
+  if (fileSize < follower->offset) {
+    fprintf(stderr, "Warning: '%s' was truncated; following from its end.\n",
+            follower->filename);
+    follower->offset = fileSize;
+  }
+  if (fileSize == follower->offset) {
+    close(fd);
+    return 0;
+  }
+
+  size_t length = fileSize - follower->offset;
+  char *buffer = malloc(length);
+  if (buffer == NULL) {
+    perror("Memory allocation failed for new words");
+    close(fd);
+    return -1;
+  }
+  size_t bytesRead = 0;
+  while (bytesRead < length) {
+    ssize_t n = pread(fd, buffer + bytesRead, length - bytesRead,
+                      follower->offset + bytesRead);
+    if (n <= 0) {
+      break; // Error, or the file shrank meanwhile; use what was read
+    }
+    bytesRead += n;
+  }
+  close(fd);
+
+  // Stop after the last complete line
+  size_t complete = bytesRead;
+  while (complete > 0 && buffer[complete - 1] != '\n') {
+    complete--;
+  }
+  SkippedLines skipped = {0, 0};
+  int newCount = appendWords(buffer, complete, wordList, &follower->capacity,
+                             *wordCount, NULL, &skipped);
+  reportSkippedLines(&skipped);
+  free(buffer);
+  if (newCount == -1) {
+    return -1;
+  }
+
+  int firstNew = *wordCount;
+  *wordCount = newCount;
+  follower->offset += complete;
+  return newCount - firstNew;
+}
+
+/**
+ * @brief Frees the memory allocated for the word list.
+ * Frees each individual word string, then frees the array of pointers.
+ * @param wordList The list of words (array of char*).
+ * @param wordCount The number of words in the list.
+ */
+void freeWordList(char **wordList, int wordCount) {
+  if (wordList == NULL) {
+    return;
+  }
+  for (int i = 0; i < wordCount; i++) {
+    if (wordList[i] != NULL) {
+      free(wordList[i]);
+      wordList[i] = NULL;
+    }
+  }
+  free(wordList);
+}
+
+/**
+ * @brief Hashes a word with FNV-1a.
+ */
+uint32_t hashWord(const char *word) {
+  uint32_t hash = FNV_OFFSET_BASIS;
+  for (const char *c = word; *c != '\0'; c++) {
+    hash = (hash ^ (unsigned char)*c) * FNV_PRIME;
   }
-  int finalWordCount = i;
+  return hash;
+}
+
+/**
+ * @brief Finds a word in the set.
+ * @return The slot holding the word's id, or the empty slot where it belongs.
+ */
+int *findWordSlot(const WordSet *set, char **wordList, const char *word) {
+  uint32_t slot = hashWord(word) & (set->capacity - 1);
+  while (set->slots[slot] != -1 && strcmp(wordList[set->slots[slot]], word)) {
+    slot = (slot + 1) & (set->capacity - 1);
+  }
+  return &set->slots[slot];
+}
 
-  if (fclose(file) == EOF) {
-    perror("Warning: Error closing file");
+/**
+ * @brief Makes room in a word set for wordCount words, rehashing the ids
+ * already in it.
+ * @return 1 on success, 0 if memory allocation failed (the set is unchanged).
+ */
+int reserveWordSet(WordSet *set, char **wordList, int wordCount) {
+  if (set->capacity >= 2 * wordCount) {
+    return 1;
+  }
+  WordSet grown = {NULL, set->capacity ? set->capacity : 1, set->wordCount};
+  while (grown.capacity < 2 * wordCount) {
+    grown.capacity *= 2; // At most half full, so probes stay short
+  }
+  grown.slots = malloc(grown.capacity * sizeof(int));
+  if (grown.slots == NULL) {
+    return 0;
+  }
+  memset(grown.slots, 0xff, grown.capacity * sizeof(int));
+  for (int slot = 0; slot < set->capacity; slot++) {
+    int id = set->slots[slot];
+    if (id != -1) {
+      *findWordSlot(&grown, wordList, wordList[id]) = id;
+    }
+  }
+  free(set->slots);
+  *set = grown;
+  return 1;
+}
+
+/**
+ * @brief Merges another dictionary into the word list, keeping one copy of
+ * each word.
+ *
+ * Words already in the list are freed as they are found, so overlapping
+ * dictionaries cost memory for their new words only. Duplicates within the
+ * original list are kept as they were loaded.
+ *
+ * @param set The words of the list, kept between merges (start with an empty
+ * set). Words added to the list since the last merge are added to it first.
+ * @param wordList The word list. Reallocated to fit the new words.
+ * @param wordCount The number of words in the list. Updated.
+ * @param extra The dictionary to merge, as returned by loadWords. Always freed.
+ * @return The number of words added, or -1 if memory allocation failed (the
+ * list is unchanged).
+ */
+int mergeWords(WordSet *set, char ***wordList, int *wordCount, char **extra,
+               int extraCount) {
+  char **grown = realloc(*wordList, (*wordCount + extraCount + 1) *
+                                        sizeof(char *));
+  if (grown != NULL) {
+    *wordList = grown;
+  }
+  if (grown == NULL ||
+      !reserveWordSet(set, *wordList, *wordCount + extraCount)) {
+    perror("Memory allocation failed for word merge");
+    freeWordList(extra, extraCount);
+    return -1;
+  }
+
+  for (; set->wordCount < *wordCount; set->wordCount++) {
+    int *slot = findWordSlot(set, *wordList, (*wordList)[set->wordCount]);
+    if (*slot == -1) {
+      *slot = set->wordCount;
+    }
+  }
+  int firstNew = *wordCount;
+  for (int i = 0; i < extraCount; i++) {
+    int *slot = findWordSlot(set, *wordList, extra[i]);
+    if (*slot == -1) {
+      *slot = *wordCount;
+      (*wordList)[(*wordCount)++] = extra[i];
+    } else {
+      free(extra[i]);
+    }
+  }
+  free(extra);
+  set->wordCount = *wordCount;
+  return *wordCount - firstNew;
+}
+
+/**
+ * @brief Removes the words added to the list since the set last saw it (by
+ * followWords) that the set already holds, so a word from a merged
+ * dictionary is not stored twice. The words kept are added to the set.
+ * @return The number of words removed, or -1 if memory allocation failed
+ * (the list is unchanged).
+ */
+int dropKnownWords(WordSet *set, char **wordList, int *wordCount) {
+  if (!reserveWordSet(set, wordList, *wordCount)) {
+    perror("Memory allocation failed for word merge");
+    return -1;
+  }
+  int kept = set->wordCount;
+  for (int i = set->wordCount; i < *wordCount; i++) {
+    int *slot = findWordSlot(set, wordList, wordList[i]);
+    if (*slot != -1) {
+      free(wordList[i]);
+      continue;
+    }
+    *slot = kept;
+    wordList[kept++] = wordList[i];
+  }
+  int dropped = *wordCount - kept;
+  *wordCount = set->wordCount = kept;
+  return dropped;
+}
+
+/**
+ * @brief Returns the set of letters in a word as a bitmask (bit 0 = 'a').
+ * @return The mask, or NOT_SPELLABLE if the word has a character outside a-z.
+ */
+uint32_t letterMask(const char *word) {
+  uint32_t mask = 0;
+  for (const char *c = word; *c != '\0'; c++) {
+    if (*c < 'a' || *c > 'z') {
+      return NOT_SPELLABLE;
+    }
+    mask |= 1u << (*c - 'a');
+  }
+  return mask;
+}
+
+/**
+ * @brief Gives an empty subset index its root node.
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int initSubsetIndex(SubsetIndex *index) {
+  index->nodeCapacity = 64;
+  index->nodes = malloc(index->nodeCapacity * sizeof(SubsetIndexNode));
+  index->nodeCount = 1; // The root; child index 0 therefore means "none"
+  if (index->nodes == NULL) {
+    return 0;
+  }
+  index->nodes[0].child[0] = index->nodes[0].child[1] = 0;
+  index->nodes[0].firstWord = -1;
+  return 1;
+}
+
+/**
+ * @brief Makes room for count more nodes.
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int reserveSubsetNodes(SubsetIndex *index, int count) {
+  if (index->nodeCount + count <= index->nodeCapacity) {
+    return 1;
+  }
+  int capacity = index->nodeCapacity * 2;
+  while (capacity < index->nodeCount + count) {
+    capacity *= 2;
+  }
+  SubsetIndexNode *nodes =
+      realloc(index->nodes, capacity * sizeof(SubsetIndexNode));
+  if (nodes == NULL) {
+    return 0;
+  }
+  index->nodes = nodes;
+  index->nodeCapacity = capacity;
+  return 1;
+}
+
+/**
+ * @brief Follows a mask's letter bits fromBit up to (not including) toBit
+ * down from node, creating missing nodes.
+ * @return The node reached, or -1 if memory allocation failed.
+ */
+int descendSubsetIndex(SubsetIndex *index, int node, uint32_t mask,
+                       int fromBit, int toBit) {
+  for (int bit = fromBit; bit < toBit; bit++) {
+    int side = (mask >> bit) & 1;
+    if (index->nodes[node].child[side] == 0) {
+      if (!reserveSubsetNodes(index, 1)) {
+        return -1;
+      }
+      SubsetIndexNode *child = &index->nodes[index->nodeCount];
+      child->child[0] = child->child[1] = 0;
+      child->firstWord = -1;
+      index->nodes[node].child[side] = index->nodeCount++;
+    }
+    node = index->nodes[node].child[side];
+  }
+  return node;
+}
+
+/**
+ * @brief Chains a word into the leaf for its mask. The root stands for
+ * letter firstBit; nextWord must already have room for wordId.
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int insertSubsetMask(SubsetIndex *index, int wordId, uint32_t mask,
+                     int firstBit) {
+  int leaf = descendSubsetIndex(index, 0, mask, firstBit, ALPHABET_SIZE);
+  if (leaf == -1) {
+    return 0;
+  }
+  index->nextWord[wordId] = index->nodes[leaf].firstWord;
+  index->nodes[leaf].firstWord = wordId;
+  return 1;
+}
+
+/**
+ * @brief Adds a word to the subset index, growing its arrays as needed.
+ *
+ * The index is a binary trie over the 26 letter bits of each word's mask.
+ * Words with the same letter set share a leaf and are chained through
+ * nextWord, so inserting never touches existing entries.
+ *
+ * @param index The index to update.
+ * @param wordId The word's position in the word list.
+ * @param word The word itself.
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int addToSubsetIndex(SubsetIndex *index, int wordId, const char *word) {
+  uint32_t mask = letterMask(word);
+
+  if (wordId >= index->wordCapacity) {
+    int capacity = index->wordCapacity ? index->wordCapacity : 64;
+    while (capacity <= wordId) {
+      capacity *= 2;
+    }
+    int *nextWord = realloc(index->nextWord, capacity * sizeof(int));
+    if (nextWord == NULL) {
+      return 0;
+    }
+    index->nextWord = nextWord;
+    index->wordCapacity = capacity;
+  }
+  index->nextWord[wordId] = -1;
+  if (mask == NOT_SPELLABLE) {
+    return 1;
+  }
+  return insertSubsetMask(index, wordId, mask, 0);
+}
+
+/**
+ * @brief Stage 1 of the parallel build: the letter masks of one slice of the
+ * word list.
+ */
+void computeMasksStage(SubsetIndexBuild *build, int thread) {
+  int begin = (int)((long)build->wordCount * thread / build->threadCount);
+  int end = (int)((long)build->wordCount * (thread + 1) / build->threadCount);
+  for (int i = begin; i < end; i++) {
+    build->masks[i] = letterMask(build->wordList[i]);
+    build->nextWord[i] = -1;
+  }
+}
+
+/**
+ * @brief Stage 2 of the parallel build: the subtries of the partitions this
+ * thread owns. Partition p holds the words whose first SUBSET_PARTITION_BITS
+ * letter bits equal p, so no two threads touch the same word or node.
+ */
+void buildPartitionsStage(SubsetIndexBuild *build, int thread) {
+  for (int p = thread; p < SUBSET_PARTITIONS; p += build->threadCount) {
+    SubsetIndex *partition = &build->partitions[p];
+    partition->nextWord = build->nextWord;
+    if (!initSubsetIndex(partition)) {
+      __atomic_store_n(&build->failed, 1, __ATOMIC_RELAXED);
+      continue;
+    }
+    for (int i = 0; i < build->wordCount; i++) {
+      uint32_t mask = build->masks[i];
+      if (mask == NOT_SPELLABLE ||
+          (mask & (SUBSET_PARTITIONS - 1)) != (uint32_t)p) {
+        continue;
+      }
+      if (!insertSubsetMask(partition, i, mask, SUBSET_PARTITION_BITS)) {
+        __atomic_store_n(&build->failed, 1, __ATOMIC_RELAXED);
+        break;
+      }
+    }
+  }
+}
+
+void *subsetIndexWorker(void *arg) {
+  SubsetIndexTask *task = arg;
+  task->stage(task->build, task->thread);
+  return NULL;
+}
+
+/**
+ * @brief Runs one stage on every build thread and waits for all of them. The
+ * calling thread runs slice 0, and any slice whose thread fails to start.
+ */
+void runSubsetIndexStage(SubsetIndexBuild *build,
+                         void (*stage)(SubsetIndexBuild *, int)) {
+  pthread_t threads[MAX_INDEX_THREADS];
+  SubsetIndexTask tasks[MAX_INDEX_THREADS];
+  int started[MAX_INDEX_THREADS] = {0};
+
+  for (int t = 0; t < build->threadCount; t++) {
+    tasks[t].build = build;
+    tasks[t].thread = t;
+    tasks[t].stage = stage;
+    if (t > 0) {
+      started[t] =
+          pthread_create(&threads[t], NULL, subsetIndexWorker, &tasks[t]) == 0;
+    }
+  }
+  for (int t = 0; t < build->threadCount; t++) {
+    if (!started[t]) {
+      stage(build, t);
+    }
+  }
+  for (int t = 1; t < build->threadCount; t++) {
+    if (started[t]) {
+      pthread_join(threads[t], NULL);
+    }
+  }
+}
+
+/**
+ * @brief Appends a partition's subtrie to the index, hanging it below the
+ * path of the partition's letter bits.
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int attachPartition(SubsetIndex *index, const SubsetIndex *partition, int p) {
+  int parent =
+      descendSubsetIndex(index, 0, (uint32_t)p, 0, SUBSET_PARTITION_BITS - 1);
+  if (parent == -1 || !reserveSubsetNodes(index, partition->nodeCount)) {
+    return 0;
+  }
+
+  int base = index->nodeCount;
+  for (int n = 0; n < partition->nodeCount; n++) {
+    SubsetIndexNode node = partition->nodes[n];
+    for (int side = 0; side < 2; side++) {
+      if (node.child[side] != 0) {
+        node.child[side] += base;
+      }
+    }
+    index->nodes[base + n] = node;
+  }
+  index->nodeCount += partition->nodeCount;
+
+  int side = (p >> (SUBSET_PARTITION_BITS - 1)) & 1;
+  index->nodes[parent].child[side] = base;
+  return 1;
+}
+
+/**
+ * @brief Builds the subset index for a word list.
+ *
+ * Large lists are built in two parallel stages, one thread per online CPU:
+ * first every word's letter mask, then one subtrie per partition of the
+ * masks. The subtries are then joined below a shared top, which touches each
+ * node once. The result is the same trie a sequential build gives.
+ *
+ * @return 1 on success, 0 if memory allocation failed (the index is freed).
+ */
+int buildSubsetIndex(SubsetIndex *index, char **wordList, int wordCount) {
+  SubsetIndexBuild build = {0};
+  build.wordList = wordList;
+  build.wordCount = wordCount;
+  build.threadCount = 1;
+  if (wordCount >= PARALLEL_INDEX_THRESHOLD) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    build.threadCount = cpus < 1                   ? 1
+                        : cpus > MAX_INDEX_THREADS ? MAX_INDEX_THREADS
+                                                   : (int)cpus;
+  }
+
+  index->nodes = NULL;
+  index->wordCapacity = wordCount > 64 ? wordCount : 64;
+  index->nextWord = malloc(index->wordCapacity * sizeof(int));
+  build.nextWord = index->nextWord;
+  build.masks = malloc((wordCount > 0 ? wordCount : 1) * sizeof(uint32_t));
+  int ok = index->nextWord != NULL && build.masks != NULL &&
+           initSubsetIndex(index);
+
+  if (ok) {
+    runSubsetIndexStage(&build, computeMasksStage);
+    runSubsetIndexStage(&build, buildPartitionsStage);
+    ok = !build.failed;
+  }
+  for (int p = 0; p < SUBSET_PARTITIONS; p++) {
+    if (ok && build.partitions[p].nodeCount > 1) {
+      ok = attachPartition(index, &build.partitions[p], p);
+    }
+    free(build.partitions[p].nodes);
+  }
+  free(build.masks);
+
+  if (!ok) {
+    perror("Memory allocation failed for subset index");
+    freeSubsetIndex(index);
+    return 0;
+  }
+  return 1;
+}
+
+void freeSubsetIndex(SubsetIndex *index) {
+  free(index->nodes);
+  free(index->nextWord);
+  index->nodes = NULL;
+  index->nextWord = NULL;
+  index->nodeCount = index->nodeCapacity = index->wordCapacity = 0;
+}
+
+/**
+ * @brief Collects the ids of every word whose letters are all in mask.
+ *
+ * Walks the trie, following the "letter present" branch only for letters in
+ * mask, so only the part of the trie that can match is visited.
+ *
+ * @param wordIds Receives the matching ids. Must have room for every word.
+ * @return The number of ids written.
+ */
+int findSubsetWords(const SubsetIndex *index, uint32_t mask, int *wordIds) {
+  int stack[ALPHABET_SIZE * 2 + 1];
+  int depth[ALPHABET_SIZE * 2 + 1];
+  int stackSize = 0;
+  int found = 0;
+
+  stack[stackSize] = 0;
+  depth[stackSize++] = 0;
+  while (stackSize > 0) {
+    stackSize--;
+    int node = stack[stackSize];
+    int bit = depth[stackSize];
+
+    if (bit == ALPHABET_SIZE) {
+      for (int id = index->nodes[node].firstWord; id != -1;
+           id = index->nextWord[id]) {
+        wordIds[found++] = id;
+      }
+      continue;
+    }
+    for (int side = 0; side <= (int)((mask >> bit) & 1); side++) {
+      int child = index->nodes[node].child[side];
+      if (child != 0) {
+        stack[stackSize] = child;
+        depth[stackSize++] = bit + 1;
+      }
+    }
+  }
+  return found;
+}
+
+int compareWords(const void *a, const void *b) {
+  return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+/**
+ * @brief Prepares a lazy index; nothing is built until lazyIndexStart.
+ * @param build Builds the index over a word list; returns NULL on failure.
+ * @param destroy Frees what build returned.
+ */
+void lazyIndexInit(LazyIndex *lazy, void *(*build)(char **, int),
+                   void (*destroy)(void *)) {
+  pthread_mutex_init(&lazy->lock, NULL);
+  pthread_cond_init(&lazy->finished, NULL);
+  lazy->state = LAZY_INDEX_IDLE;
+  lazy->words = NULL;
+  lazy->wordCount = 0;
+  lazy->index = NULL;
+  lazy->build = build;
+  lazy->destroy = destroy;
+  lazy->hasThread = 0;
+}
+
+void *lazyIndexWorker(void *arg) {
+  LazyIndex *lazy = arg;
+  void *index = lazy->build(lazy->words, lazy->wordCount);
+
+  pthread_mutex_lock(&lazy->lock);
+  free(lazy->words); // The snapshot is only needed while building
+  lazy->words = NULL;
+  lazy->index = index;
+  lazy->state = index != NULL ? LAZY_INDEX_READY : LAZY_INDEX_FAILED;
+  pthread_cond_broadcast(&lazy->finished);
+  pthread_mutex_unlock(&lazy->lock);
+  return NULL;
+}
+
+/**
+ * @brief Starts building the index on a background thread, the first time it
+ * is called; later calls do nothing.
+ *
+ * The thread works on a copy of the list's pointers, so the caller may grow
+ * (reallocate) the list meanwhile. Words added after the snapshot are not in
+ * the index; lazy->wordCount tells how many are. If no thread can be started
+ * the index is built right away.
+ */
+void lazyIndexStart(LazyIndex *lazy, char **wordList, int wordCount) {
+  pthread_mutex_lock(&lazy->lock);
+  if (lazy->state != LAZY_INDEX_IDLE) {
+    pthread_mutex_unlock(&lazy->lock);
+    return;
+  }
+  lazy->words = malloc((wordCount > 0 ? wordCount : 1) * sizeof(char *));
+  if (lazy->words == NULL) {
+    perror("Memory allocation failed for index snapshot");
+    lazy->state = LAZY_INDEX_FAILED;
+    pthread_mutex_unlock(&lazy->lock);
+    return;
+  }
+  memcpy(lazy->words, wordList, wordCount * sizeof(char *));
+  lazy->wordCount = wordCount;
+  lazy->state = LAZY_INDEX_BUILDING;
+  pthread_mutex_unlock(&lazy->lock);
+
+  lazy->hasThread =
+      pthread_create(&lazy->thread, NULL, lazyIndexWorker, lazy) == 0;
+  if (!lazy->hasThread) {
+    lazyIndexWorker(lazy);
+  }
+}
+
+/**
+ * @brief Returns the index if it is built.
+ * @param wait If non-zero, waits for a build in progress to finish.
+ * @return The index, or NULL if it is not (yet) available; the caller can
+ * then use a slower path that needs no index.
+ */
+void *lazyIndexGet(LazyIndex *lazy, int wait) {
+  pthread_mutex_lock(&lazy->lock);
+  while (wait && lazy->state == LAZY_INDEX_BUILDING) {
+    pthread_cond_wait(&lazy->finished, &lazy->lock);
+  }
+  void *index = lazy->state == LAZY_INDEX_READY ? lazy->index : NULL;
+  pthread_mutex_unlock(&lazy->lock);
+  return index;
+}
+
+/**
+ * @brief Waits for any build in progress, then frees the index.
+ */
+void lazyIndexFree(LazyIndex *lazy) {
+  if (lazy->hasThread) {
+    pthread_join(lazy->thread, NULL);
+  }
+  if (lazy->index != NULL) {
+    lazy->destroy(lazy->index);
+  }
+  free(lazy->words);
+  pthread_cond_destroy(&lazy->finished);
+  pthread_mutex_destroy(&lazy->lock);
+}
+
+void *buildSubsetIndexLazily(char **wordList, int wordCount) {
+  SubsetIndex *index = malloc(sizeof(SubsetIndex));
+  if (index == NULL || !buildSubsetIndex(index, wordList, wordCount)) {
+    free(index);
+    return NULL;
+  }
+  return index;
+}
+
+void destroySubsetIndex(void *index) {
+  freeSubsetIndex(index);
+  free(index);
+}
+
+/**
+ * @brief Collects the ids of every word whose letters are all in mask by
+ * checking each word. Used while the subset index is still being built.
+ * @return The number of ids written.
+ */
+int scanSubsetWords(char **wordList, int wordCount, uint32_t mask,
+                    int *wordIds) {
+  int found = 0;
+  for (int i = 0; i < wordCount; i++) {
+    uint32_t wordMask = letterMask(wordList[i]);
+    if (wordMask != NOT_SPELLABLE && (wordMask & ~mask) == 0) {
+      wordIds[found++] = i;
+    }
+  }
+  return found;
+}
+
+/**
+ * @brief Returns the Levenshtein distance between two words (insertions,
+ * deletions and substitutions of one letter each cost 1), if it is at most
+ * bound. Used for guesses too long for myersDistance.
+ *
+ * @param b A word shorter than MAX_WORD_LENGTH.
+ * @return The distance, or bound + 1 if it is larger than bound.
+ */
+int editDistance(const char *a, const char *b, int bound) {
+  int lengthA = (int)strlen(a);
+  int lengthB = (int)strlen(b);
+  int row[MAX_WORD_LENGTH]; // Distances from a's prefix to b's prefixes
+  for (int j = 0; j <= lengthB; j++) {
+    row[j] = j;
+  }
+  for (int i = 1; i <= lengthA; i++) {
+    int diagonal = row[0];
+    int rowMinimum = row[0] = i;
+    for (int j = 1; j <= lengthB; j++) {
+      int substitute = diagonal + (a[i - 1] != b[j - 1]);
+      int insertOrDelete = (row[j] < row[j - 1] ? row[j] : row[j - 1]) + 1;
+      diagonal = row[j];
+      row[j] = substitute < insertOrDelete ? substitute : insertOrDelete;
+      rowMinimum = row[j] < rowMinimum ? row[j] : rowMinimum;
+    }
+    if (rowMinimum > bound) {
+      return bound + 1;
+    }
+  }
+  return row[lengthB] <= bound ? row[lengthB] : bound + 1;
+}
+
+/**
+ * @brief Returns the Levenshtein distance between a pattern of at most 64
+ * letters and a word, if it is at most bound.
+ *
+ * Myers' bit-parallel algorithm (Hyyro's form for whole-word distance): one
+ * column of the edit-distance table is held as bit vectors of +1/-1 steps, so
+ * each letter of the word costs a few 64-bit operations for the whole
+ * pattern.
+ *
+ * @param positions For each letter, the set of pattern positions holding it.
+ * @param word A lowercase word.
+ * @return The distance, or bound + 1 if it is larger than bound.
+ */
+int myersDistance(const uint64_t positions[ALPHABET_SIZE], int patternLength,
+                  const char *word, int wordLength, int bound) {
+  uint64_t plus = ~0ull; // Vertical +1 steps
+  uint64_t minus = 0;    // Vertical -1 steps
+  uint64_t last = 1ull << (patternLength - 1);
+  int distance = patternLength;
+  for (int j = 0; j < wordLength; j++) {
+    uint64_t match = positions[word[j] - 'a'];
+    uint64_t vertical = match | minus;
+    uint64_t horizontal = (((match & plus) + plus) ^ plus) | match;
+    uint64_t horizontalPlus = minus | ~(horizontal | plus);
+    uint64_t horizontalMinus = plus & horizontal;
+    distance += (horizontalPlus & last) != 0;
+    distance -= (horizontalMinus & last) != 0;
+    if (distance - (wordLength - j - 1) > bound) {
+      return bound + 1; // Each remaining letter lowers it by at most 1
+    }
+    horizontalPlus = (horizontalPlus << 1) | 1; // Row 0 grows by 1 a column
+    horizontalMinus <<= 1;
+    plus = horizontalMinus | ~(vertical | horizontalPlus);
+    minus = horizontalPlus & vertical;
+  }
+  return distance <= bound ? distance : bound + 1;
+}
+
+/**
+ * @brief Adds a word to the spelling index.
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int addToSpellIndex(SpellIndex *index, int wordId, const char *word) {
+  LengthBucket *bucket = &index->buckets[strlen(word)];
+  if (bucket->count == bucket->capacity) {
+    int newCapacity = bucket->capacity ? bucket->capacity * 2 : 16;
+    int *grown = realloc(bucket->wordIds, newCapacity * sizeof(int));
+    if (grown == NULL) {
+      return 0;
+    }
+    bucket->wordIds = grown;
+    bucket->capacity = newCapacity;
+  }
+  bucket->wordIds[bucket->count++] = wordId;
+  return 1;
+}
+
+void *buildSpellIndexLazily(char **wordList, int wordCount) {
+  SpellIndex *index = calloc(1, sizeof(SpellIndex));
+  if (index == NULL) {
+    return NULL;
+  }
+  for (int i = 0; i < wordCount; i++) {
+    if (!addToSpellIndex(index, i, wordList[i])) {
+      perror("Memory allocation failed for spelling index");
+      destroySpellIndex(index);
+      return NULL;
+    }
+  }
+  return index;
+}
+
+void destroySpellIndex(void *index) {
+  SpellIndex *spellIndex = index;
+  if (spellIndex != NULL) {
+    for (int length = 0; length < MAX_WORD_LENGTH; length++) {
+      free(spellIndex->buckets[length].wordIds);
+    }
+    free(spellIndex);
+  }
+}
+
+/**
+ * @brief Inserts a match into a list kept sorted by distance, then word id,
+ * and capped at MAX_SUGGESTIONS entries.
+ */
+void addSuggestion(Suggestion *matches, int *matchCount, Suggestion match) {
+  int i = *matchCount < MAX_SUGGESTIONS ? (*matchCount)++ : MAX_SUGGESTIONS;
+  while (i > 0 && (matches[i - 1].distance > match.distance ||
+                   (matches[i - 1].distance == match.distance &&
+                    matches[i - 1].wordId > match.wordId))) {
+    if (i < MAX_SUGGESTIONS) {
+      matches[i] = matches[i - 1];
+    }
+    i--;
+  }
+  if (i < MAX_SUGGESTIONS) {
+    matches[i] = match;
+  }
+}
+
+/**
+ * @brief Finds the dictionary words closest to a guess, within maxDistance.
+ *
+ * Only the length buckets within maxDistance of the guess's length can hold
+ * matches. Each candidate is checked with myersDistance, which also gives up
+ * early on words that cannot come within maxDistance.
+ *
+ * @param guess A lowercase word shorter than MAX_WORD_LENGTH.
+ * @param matches Receives at most MAX_SUGGESTIONS distinct words, closest
+ * first.
+ * @return The number of matches.
+ */
+int findSuggestions(const SpellIndex *index, char **wordList,
+                    const char *guess, int maxDistance, Suggestion *matches) {
+  int guessLength = (int)strlen(guess);
+  uint64_t positions[ALPHABET_SIZE] = {0};
+  for (int i = 0; i < guessLength && i < 64; i++) {
+    positions[guess[i] - 'a'] |= 1ull << i;
+  }
+
+  int matchCount = 0;
+  int shortest = guessLength > maxDistance ? guessLength - maxDistance : 0;
+  for (int length = shortest;
+       length <= guessLength + maxDistance && length < MAX_WORD_LENGTH;
+       length++) {
+    const LengthBucket *bucket = &index->buckets[length];
+    for (int k = 0; k < bucket->count; k++) {
+      int wordId = bucket->wordIds[k];
+      int distance =
+          guessLength <= 64
+              ? myersDistance(positions, guessLength, wordList[wordId], length,
+                              maxDistance)
+              : editDistance(guess, wordList[wordId], maxDistance);
+      if (distance > maxDistance) {
+        continue;
+      }
+      // A word on several dictionary lines is suggested once: its first
+      // copy (lowest id, same bucket) was already considered
+      int seen = 0;
+      for (int m = 0; m < matchCount && !seen; m++) {
+        seen = strcmp(wordList[matches[m].wordId], wordList[wordId]) == 0;
+      }
+      if (!seen) {
+        Suggestion match = {wordId, distance};
+        addSuggestion(matches, &matchCount, match);
+      }
+    }
+  }
+  return matchCount;
+}
+
+/**
+ * @brief Checks a whole-word guess. If the guess is not a dictionary word,
+ * prints the closest dictionary words (up to MAX_SUGGESTION_DISTANCE edits).
+ *
+ * The spelling index is built in the background from the start of the
+ * round (see main); this waits for it only if the build is still running.
+ *
+ * @param guess The guess, lowercase and shorter than MAX_WORD_LENGTH.
+ * @return WORD_GUESS_CORRECT, WORD_GUESS_WRONG (a dictionary word, but not
+ * the secret word) or WORD_GUESS_UNKNOWN (not in the dictionary).
+ */
+int checkWordGuess(LazyIndex *spellIndex, char **wordList, int wordCount,
+                   const char *secretWord, const char *guess) {
+  if (strcmp(guess, secretWord) == 0) {
+    return WORD_GUESS_CORRECT;
+  }
+
+  SpellIndex *index = lazyIndexGet(spellIndex, 1);
+  for (; index != NULL && spellIndex->wordCount < wordCount;
+       spellIndex->wordCount++) {
+    if (!addToSpellIndex(index, spellIndex->wordCount,
+                         wordList[spellIndex->wordCount])) {
+      perror("Memory allocation failed for spelling index");
+      index = NULL;
+    }
+  }
+  if (index == NULL) {
+    return WORD_GUESS_WRONG; // No index to check against; count the guess
+  }
+
+  Suggestion matches[MAX_SUGGESTIONS];
+  int matchCount = findSuggestions(index, wordList, guess,
+                                   MAX_SUGGESTION_DISTANCE, matches);
+  if (matchCount > 0 && matches[0].distance == 0) {
+    return WORD_GUESS_WRONG;
+  }
+
+  printf("\n-> '%s' is not in the dictionary.", guess);
+  if (matchCount > 0) {
+    printf(" Did you mean:");
+    for (int i = 0; i < matchCount; i++) {
+      printf(" %s", wordList[matches[i].wordId]);
+    }
+  }
+  printf("\n");
+  return WORD_GUESS_UNKNOWN;
+}
+
+/**
+ * @brief Lists every dictionary word spellable from the guessed letters and
+ * prints the bonus score (one point per letter of each word).
+ *
+ * Uses the subset index once its background build is done, first adding any
+ * words loaded after the build started; until then it scans the word list.
+ * Words are listed alphabetically, and a word the dictionary holds more than
+ * once is listed and scored once.
+ * @param arena The round's arena, for the list of matches.
+ */
+void printBonusWords(LazyIndex *lazyIndex, char **wordList, int wordCount,
+                     const char *guessedLetters, RoundArena *arena) {
+  int *wordIds = roundArenaAlloc(arena, wordCount * sizeof(int));
+  if (wordIds == NULL) {
+    return;
+  }
+
+  uint32_t mask = letterMask(guessedLetters);
+  SubsetIndex *index = lazyIndexGet(lazyIndex, 0);
+  for (; index != NULL && lazyIndex->wordCount < wordCount;
+       lazyIndex->wordCount++) {
+    if (!addToSubsetIndex(index, lazyIndex->wordCount,
+                          wordList[lazyIndex->wordCount])) {
+      perror("Memory allocation failed for subset index");
+      index = NULL;
+    }
+  }
+  int found = index != NULL
+                  ? findSubsetWords(index, mask, wordIds)
+                  : scanSubsetWords(wordList, wordCount, mask, wordIds);
+  const char **words = roundArenaAlloc(arena, found * sizeof(char *));
+  if (words == NULL) {
+    return;
+  }
+  for (int i = 0; i < found; i++) {
+    words[i] = wordList[wordIds[i]];
+  }
+  qsort(words, found, sizeof(char *), compareWords);
+
+  int distinct = 0; // Duplicate lines sort next to each other; keep one
+  for (int i = 0; i < found; i++) {
+    if (distinct == 0 || strcmp(words[i], words[distinct - 1]) != 0) {
+      words[distinct++] = words[i];
+    }
+  }
+
+  int bonusScore = 0;
+  printf("\n--- Bonus Words (%d) ---\n", distinct);
+  for (int i = 0; i < distinct; i++) {
+    bonusScore += strlen(words[i]);
+    printf("%s%s", words[i],
+           (i + 1) % BONUS_WORDS_PER_LINE == 0 ? "\n" : " ");
+  }
+  if (distinct % BONUS_WORDS_PER_LINE != 0) {
+    printf("\n");
+  }
+  printf("Bonus score: %d\n", bonusScore);
+}
+
+/**
+ * @brief Computes a word's anagram signature: how many times each letter
+ * occurs, 4 bits per letter ('a'-'p' in packed[0], 'q'-'z' in packed[1]).
+ * Two words are anagrams exactly when their signatures are equal.
+ * @return 1 on success, 0 if the word has a character outside a-z or a
+ * letter more than ANAGRAM_MAX_COUNT times.
+ */
+int anagramSignature(const char *word, AnagramSignature *signature) {
+  signature->packed[0] = signature->packed[1] = 0;
+  for (const char *c = word; *c != '\0'; c++) {
+    if (*c < 'a' || *c > 'z') {
+      return 0;
+    }
+    int letter = *c - 'a';
+    int shift = letter % ANAGRAM_LETTERS_PER_WORD * ANAGRAM_COUNT_BITS;
+    uint64_t *packed = &signature->packed[letter / ANAGRAM_LETTERS_PER_WORD];
+    if ((*packed >> shift & ANAGRAM_MAX_COUNT) == ANAGRAM_MAX_COUNT) {
+      return 0;
+    }
+    *packed += 1ull << shift;
+  }
+  return 1;
+}
+
+/**
+ * @brief Hashes an anagram signature with FNV-1a over its bytes.
+ */
+uint32_t hashSignature(const AnagramSignature *signature) {
+  uint32_t hash = FNV_OFFSET_BASIS;
+  for (int i = 0; i < 2; i++) {
+    for (int byte = 0; byte < 8; byte++) {
+      hash = (hash ^ (uint8_t)(signature->packed[i] >> (byte * 8))) * FNV_PRIME;
+    }
+  }
+  return hash;
+}
+
+/**
+ * @brief Finds the group of words with a signature.
+ * @return The slot holding the group, or the empty slot where it belongs.
+ */
+AnagramGroup *findAnagramGroup(const AnagramIndex *index,
+                               const AnagramSignature *signature) {
+  uint32_t slot = hashSignature(signature) & (index->capacity - 1);
+  while (index->slots[slot].firstWord != -1 &&
+         (index->slots[slot].signature.packed[0] != signature->packed[0] ||
+          index->slots[slot].signature.packed[1] != signature->packed[1])) {
+    slot = (slot + 1) & (index->capacity - 1);
+  }
+  return &index->slots[slot];
+}
+
+/**
+ * @brief Resizes the group table to capacity slots (a power of two).
+ * @return 1 on success, 0 if memory allocation failed (the index is
+ * unchanged).
+ */
+int resizeAnagramIndex(AnagramIndex *index, int capacity) {
+  AnagramIndex resized = *index;
+  resized.capacity = capacity;
+  resized.slots = malloc(capacity * sizeof(AnagramGroup));
+  if (resized.slots == NULL) {
+    return 0;
+  }
+  for (int slot = 0; slot < capacity; slot++) {
+    resized.slots[slot].firstWord = -1;
+  }
+  for (int slot = 0; slot < index->capacity; slot++) {
+    if (index->slots[slot].firstWord != -1) {
+      *findAnagramGroup(&resized, &index->slots[slot].signature) =
+          index->slots[slot];
+    }
+  }
+  free(index->slots);
+  *index = resized;
+  return 1;
+}
+
+/**
+ * @brief Adds the next word of the word list (id index->wordCount) to the
+ * anagram index, growing its arrays as needed.
+ *
+ * Words with the same signature share a group and are chained through
+ * nextWord. A word already in its group (a duplicate line) is not chained
+ * again, and words without a signature are left out.
+ *
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int addToAnagramIndex(AnagramIndex *index, char **wordList) {
+  int wordId = index->wordCount;
+  if (wordId >= index->wordCapacity) {
+    int capacity = index->wordCapacity ? index->wordCapacity * 2 : 64;
+    int *nextWord = realloc(index->nextWord, capacity * sizeof(int));
+    if (nextWord == NULL) {
+      return 0;
+    }
+    index->nextWord = nextWord;
+    index->wordCapacity = capacity;
+  }
+  if (2 * (index->groupCount + 1) > index->capacity &&
+      !resizeAnagramIndex(index, index->capacity * 2)) {
+    return 0; // Keeps the table at most half full
+  }
+  index->nextWord[wordId] = -1;
+  index->wordCount++;
+
+  AnagramSignature signature;
+  if (!anagramSignature(wordList[wordId], &signature)) {
+    return 1;
+  }
+  AnagramGroup *group = findAnagramGroup(index, &signature);
+  if (group->firstWord == -1) {
+    group->signature = signature;
+    group->wordCount = 0;
+    index->groupCount++;
+  }
+  for (int id = group->firstWord; id != -1; id = index->nextWord[id]) {
+    if (strcmp(wordList[id], wordList[wordId]) == 0) {
+      return 1;
+    }
+  }
+  index->nextWord[wordId] = group->firstWord;
+  group->firstWord = wordId;
+  group->wordCount++;
+  return 1;
+}
+
+/**
+ * @brief Builds the anagram index of a word list in one pass.
+ *
+ * The table and the chain array are sized for the whole list up front, so
+ * the pass never resizes them.
+ *
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int buildAnagramIndex(AnagramIndex *index, char **wordList, int wordCount) {
+  int capacity = 1;
+  while (capacity < 2 * wordCount) {
+    capacity *= 2; // One group per word at most, so at most half full
+  }
+  index->slots = NULL;
+  index->capacity = 0;
+  index->groupCount = 0;
+  index->nextWord = malloc((wordCount > 0 ? wordCount : 1) * sizeof(int));
+  index->wordCapacity = wordCount;
+  index->wordCount = 0;
+  if (index->nextWord == NULL || !resizeAnagramIndex(index, capacity)) {
+    perror("Memory allocation failed for anagram index");
+    freeAnagramIndex(index);
+    return 0;
+  }
+  while (index->wordCount < wordCount) {
+    if (!addToAnagramIndex(index, wordList)) {
+      perror("Memory allocation failed for anagram index");
+      freeAnagramIndex(index);
+      return 0;
+    }
   }
-  *wordCount = finalWordCount;
+  return 1;
+}
 
-  return wordList;
+void freeAnagramIndex(AnagramIndex *index) {
+  free(index->slots);
+  free(index->nextWord);
+  index->slots = NULL;
+  index->nextWord = NULL;
+  index->capacity = index->groupCount = 0;
+  index->wordCapacity = index->wordCount = 0;
 }
 
 /**
- * @brief Frees the memory allocated for the word list.
- * Frees each individual word string, then frees the array of pointers.
- * @param wordList The list of words (array of char*).
- * @param wordCount The number of words in the list.
+ * @brief After a solved round, asks the player for every other dictionary
+ * word made of the same letters, and prints the anagram score.
+ *
+ * Each submission is looked up by its signature in the anagram index, so
+ * checking it does not depend on the size of the word list.
+ *
+ * @param arena The round's arena, for the found flags.
  */
-void freeWordList(char **wordList, int wordCount) {
-  if (wordList == NULL) {
+void playAnagramRound(const AnagramIndex *index, char **wordList,
+                      const char *secretWord, RoundArena *arena) {
+  AnagramSignature secretSignature;
+  if (!anagramSignature(secretWord, &secretSignature)) {
     return;
   }
-  for (int i = 0; i < wordCount; i++) {
-    if (wordList[i] != NULL) {
-      free(wordList[i]);
-      wordList[i] = NULL;
+  const AnagramGroup *group = findAnagramGroup(index, &secretSignature);
+  int anagramCount = group->wordCount - 1; // Not counting the secret word
+  if (group->firstWord == -1 || anagramCount <= 0) {
+    printf("\n-> '%s' has no anagrams in the dictionary.\n", secretWord);
+    return;
+  }
+  char *found = roundArenaAlloc(arena, group->wordCount); // By chain position
+  if (found == NULL) {
+    return;
+  }
+  memset(found, 0, group->wordCount);
+
+  printf("\n--- Anagrams ---\n");
+  printf("'%s' has %d anagram%s in the dictionary. Find %s (empty line to "
+         "give up).\n",
+         secretWord, anagramCount, anagramCount == 1 ? "" : "s",
+         anagramCount == 1 ? "it" : "them all");
+  int foundCount = 0;
+  char inputBuffer[GUESS_BUFFER_SIZE];
+  while (foundCount < anagramCount) {
+    printf("Anagram (%d/%d): ", foundCount, anagramCount);
+    if (fgets(inputBuffer, sizeof(inputBuffer), stdin) == NULL) {
+      printf("\n");
+      break;
+    }
+    if (strchr(inputBuffer, '\n') == NULL) {
+      consumeRemainingInput();
+    }
+    size_t length = strcspn(inputBuffer, "\r\n");
+    if (length == 0) {
+      break; // Gave up
+    }
+    inputBuffer[length] = '\0';
+    copyLowercase(inputBuffer, inputBuffer, length);
+
+    AnagramSignature signature;
+    const AnagramGroup *submitted = anagramSignature(inputBuffer, &signature)
+                                        ? findAnagramGroup(index, &signature)
+                                        : NULL;
+    if (submitted != group) {
+      printf("-> '%s' is not an anagram of '%s'.\n", inputBuffer,
+             secretWord);
+      continue;
+    }
+    int position = 0;
+    int id = group->firstWord;
+    while (id != -1 && strcmp(wordList[id], inputBuffer) != 0) {
+      id = index->nextWord[id];
+      position++;
+    }
+    if (id == -1) {
+      printf("-> '%s' is not in the dictionary.\n", inputBuffer);
+    } else if (strcmp(inputBuffer, secretWord) == 0 || found[position]) {
+      printf("-> You already have '%s'.\n", inputBuffer);
+    } else {
+      found[position] = 1;
+      foundCount++;
+      printf("-> '%s' is an anagram!\n", inputBuffer);
     }
   }
-  free(wordList);
+
+  if (foundCount < anagramCount) {
+    printf("Missed:");
+    int position = 0;
+    for (int id = group->firstWord; id != -1; id = index->nextWord[id]) {
+      if (!found[position++] && strcmp(wordList[id], secretWord) != 0) {
+        printf(" %s", wordList[id]);
+      }
+    }
+    printf("\n");
+  }
+  printf("Anagram score: %d/%d\n", foundCount, anagramCount);
 }
 
 void clearScreen() {
@@ -285,33 +2265,758 @@ void drawHangman(int incorrectGuesses) {
   printf("\n"); // Add a little space after the drawing
 }
 
-int main() {
-  srand(time(NULL));
+/**
+ * @brief Prepares an arena with room for size bytes.
+ * @return 1 on success, 0 if memory allocation failed.
+ */
+int initRoundArena(RoundArena *arena, size_t size) {
+  arena->base = malloc(size);
+  arena->size = arena->base != NULL ? size : 0;
+  arena->used = 0;
+  arena->requested = 0;
+  arena->overflow = NULL;
+  if (arena->base == NULL) {
+    perror("Memory allocation failed for round arena");
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Allocates memory that lives until the next resetRoundArena.
+ *
+ * Normally a pointer bump. An allocation that does not fit gets its own
+ * block, and the arena grows at the next reset so the same round fits then.
+ *
+ * @return The memory (aligned to ROUND_ARENA_ALIGNMENT), or NULL if memory
+ * allocation failed.
+ */
+void *roundArenaAlloc(RoundArena *arena, size_t bytes) {
+  bytes = (bytes + ROUND_ARENA_ALIGNMENT - 1) &
+          ~(size_t)(ROUND_ARENA_ALIGNMENT - 1);
+  arena->requested += bytes;
+  if (bytes <= arena->size - arena->used) {
+    void *memory = arena->base + arena->used;
+    arena->used += bytes;
+    return memory;
+  }
+
+  // The block's first ROUND_ARENA_ALIGNMENT bytes link it to the others
+  char *block = malloc(ROUND_ARENA_ALIGNMENT + bytes);
+  if (block == NULL) {
+    perror("Memory allocation failed for round arena");
+    return NULL;
+  }
+  memcpy(block, &arena->overflow, sizeof(char *));
+  arena->overflow = block;
+  return block + ROUND_ARENA_ALIGNMENT;
+}
+
+/**
+ * @brief Frees everything allocated from the arena since the last reset.
+ *
+ * Takes constant time unless the round overflowed the arena; then the extra
+ * blocks are freed and the arena is resized to what the round needed.
+ */
+void resetRoundArena(RoundArena *arena) {
+  while (arena->overflow != NULL) {
+    char *next;
+    memcpy(&next, arena->overflow, sizeof(char *));
+    free(arena->overflow);
+    arena->overflow = next;
+  }
+  if (arena->requested > arena->size) {
+    char *grown = malloc(arena->requested);
+    if (grown != NULL) { // Otherwise keep the old size and overflow again
+      free(arena->base);
+      arena->base = grown;
+      arena->size = arena->requested;
+    }
+  }
+  arena->used = 0;
+  arena->requested = 0;
+}
+
+void freeRoundArena(RoundArena *arena) {
+  resetRoundArena(arena);
+  free(arena->base);
+  arena->base = NULL;
+  arena->size = 0;
+}
+
+/**
+ * @brief Returns the random value for one game, derived only from the seed and
+ * the game's index.
+ *
+ * Uses the counter-based Philox4x32-10 generator: the game index is the
+ * counter and the seed is the key, so there is no shared sequential state like
+ * rand(). Game N always gets the same value for a given seed, no matter how
+ * many games were played before it or in which order.
+ *
+ * @param seed The session seed (the key).
+ * @param gameIndex The zero-based index of the game (the counter).
+ * @return 64 pseudo-random bits.
+ */
+uint64_t gameRandom(uint64_t seed, uint64_t gameIndex) {
+  uint32_t ctr[4] = {(uint32_t)gameIndex, (uint32_t)(gameIndex >> 32), 0, 0};
+  uint32_t key[2] = {(uint32_t)seed, (uint32_t)(seed >> 32)};
+
+  for (int round = 0; round < PHILOX_ROUNDS; round++) {
+    uint64_t product0 = (uint64_t)PHILOX_M0 * ctr[0];
+    uint64_t product1 = (uint64_t)PHILOX_M1 * ctr[2];
+    uint32_t next[4] = {
+        (uint32_t)(product1 >> 32) ^ ctr[1] ^ key[0], (uint32_t)product1,
+        (uint32_t)(product0 >> 32) ^ ctr[3] ^ key[1], (uint32_t)product0};
+    memcpy(ctr, next, sizeof(ctr));
+    key[0] += PHILOX_W0;
+    key[1] += PHILOX_W1;
+  }
+  return ((uint64_t)ctr[0] << 32) | ctr[1];
+}
+
+/**
+ * @brief Reveals every occurrence of a guessed letter in the display word.
+ * @param secretWord The word being guessed.
+ * @param displayWord The revealed word, '_' for hidden letters. Updated in
+ * place.
+ * @param guess The guessed letter.
+ * @return The number of positions revealed (0 if the guess was incorrect).
+ */
+int revealLetter(const char *secretWord, char *displayWord, char guess) {
+  int revealed = 0;
+  for (size_t i = 0; secretWord[i] != '\0'; i++) {
+    if (secretWord[i] == guess) {
+      displayWord[i] = guess;
+      revealed++;
+    }
+  }
+  return revealed;
+}
+
+/**
+ * @brief Same as revealLetter for a packed secret word: finds every position
+ * of the letter with one SWAR comparison instead of a scan.
+ */
+int revealPackedLetter(uint64_t packedSecret, char *displayWord, char guess) {
+  uint32_t positions = packedLetterPositions(packedSecret, guess);
+  for (uint32_t p = positions; p != 0; p &= p - 1) {
+    displayWord[__builtin_ctz(p)] = guess;
+  }
+  return __builtin_popcount(positions);
+}
+
+/**
+ * @brief Plays one game with a loaded strategy and no output.
+ *
+ * Invalid or repeated guesses count as incorrect, so every game ends within
+ * ALPHABET_SIZE + maxIncorrectGuesses turns.
+ *
+ * @param frequencies The words' corpus frequencies, or NULL. Given to
+ * strategies that implement createWeightedGame.
+ * @param maxThreads The threads the strategy may use per turn, counting the
+ * calling one.
+ * @param incorrectGuessesOut Receives the number of incorrect guesses made.
+ * @return 1 if the strategy guessed the word, 0 otherwise.
+ */
+int playStrategyGame(const HangmanStrategy *strategy, char **wordList,
+                     const uint32_t *frequencies, int wordCount,
+                     const char *secretWord, int maxIncorrectGuesses,
+                     int maxThreads, int *incorrectGuessesOut) {
+  size_t wordLength = strlen(secretWord);
+  char displayWord[MAX_WORD_LENGTH];
+  memset(displayWord, '_', wordLength);
+  displayWord[wordLength] = '\0';
+
+  char guessedLetters[ALPHABET_SIZE + 1] = {0};
+  int numGuessedLetters = 0;
+  int incorrectGuesses = 0;
+  int hiddenLetters = (int)wordLength;
+  uint64_t packedSecret = 0;
+  int isPacked = packWord(secretWord, &packedSecret);
+
+  void *game;
+  if (frequencies != NULL && strategy->abiVersion >= 2 &&
+      strategy->createWeightedGame != NULL) {
+    game = strategy->createWeightedGame((const char *const *)wordList,
+                                        frequencies, wordCount,
+                                        (int)wordLength);
+  } else {
+    game = strategy->createGame((const char *const *)wordList, wordCount,
+                                (int)wordLength);
+  }
+  while (hiddenLetters > 0 && incorrectGuesses < maxIncorrectGuesses) {
+    HangmanTurn turn = {displayWord, guessedLetters, incorrectGuesses,
+                        maxIncorrectGuesses, maxThreads};
+    char guess = tolower((unsigned char)strategy->nextGuess(game, &turn));
+
+    if (guess < 'a' || guess > 'z' || strchr(guessedLetters, guess) != NULL) {
+      incorrectGuesses++;
+      continue;
+    }
+    guessedLetters[numGuessedLetters++] = guess;
+
+    int revealed = isPacked
+                       ? revealPackedLetter(packedSecret, displayWord, guess)
+                       : revealLetter(secretWord, displayWord, guess);
+    if (revealed == 0) {
+      incorrectGuesses++;
+    }
+    hiddenLetters -= revealed;
+  }
+  if (strategy->destroyGame != NULL) {
+    strategy->destroyGame(game);
+  }
+
+  *incorrectGuessesOut = incorrectGuesses;
+  return hiddenLetters == 0;
+}
+
+static const int difficultyGuesses[DIFFICULTY_COUNT] = {
+    EASY_GUESSES, MEDIUM_GUESSES, HARD_GUESSES};
+static const char *const difficultyNames[DIFFICULTY_COUNT] = {"Easy", "Medium",
+                                                              "Hard"};
+
+/**
+ * @brief Results of one strategy at one difficulty.
+ */
+typedef struct {
+  long gamesWon;
+  long gamesPlayed;
+  long incorrectGuesses;
+} TournamentScore;
+
+/**
+ * @brief State shared by all tournament worker threads.
+ *
+ * Every (strategy, difficulty, word) triple is one job. Workers claim chunks
+ * of job numbers from nextJob and add their totals to scores when done, so the
+ * results do not depend on the number of threads or on scheduling.
+ */
+typedef struct {
+  const HangmanStrategy **strategies;
+  int strategyCount;
+  char **wordList;
+  const uint32_t *frequencies; // Corpus frequencies by word id, or NULL
+  int wordCount;
+  long totalJobs;
+  long nextJob;            // Updated atomically
+  TournamentScore *scores; // [strategy * DIFFICULTY_COUNT + difficulty]
+  int threadsPerGame;      // HangmanTurn.maxThreads for every game
+} Tournament;
+
+void *tournamentWorker(void *arg) {
+  Tournament *tournament = arg;
+  int scoreCount = tournament->strategyCount * DIFFICULTY_COUNT;
+  TournamentScore *localScores = calloc(scoreCount, sizeof(TournamentScore));
+  if (localScores == NULL) {
+    perror("Memory allocation failed for tournament scores");
+    return (void *)1;
+  }
+
+  for (;;) {
+    long first = __atomic_fetch_add(&tournament->nextJob,
+                                    TOURNAMENT_CHUNK_SIZE, __ATOMIC_RELAXED);
+    if (first >= tournament->totalJobs) {
+      break;
+    }
+    long last = first + TOURNAMENT_CHUNK_SIZE;
+    if (last > tournament->totalJobs) {
+      last = tournament->totalJobs;
+    }
+
+    for (long job = first; job < last; job++) {
+      int wordIndex = job % tournament->wordCount;
+      int difficulty = (job / tournament->wordCount) % DIFFICULTY_COUNT;
+      int strategyIndex = job / tournament->wordCount / DIFFICULTY_COUNT;
+      int incorrectGuesses = 0;
+
+      int won = playStrategyGame(
+          tournament->strategies[strategyIndex], tournament->wordList,
+          tournament->frequencies, tournament->wordCount,
+          tournament->wordList[wordIndex], difficultyGuesses[difficulty],
+          tournament->threadsPerGame, &incorrectGuesses);
+
+      TournamentScore *score =
+          &localScores[strategyIndex * DIFFICULTY_COUNT + difficulty];
+      score->gamesWon += won;
+      score->gamesPlayed++;
+      score->incorrectGuesses += incorrectGuesses;
+    }
+  }
+
+  for (int i = 0; i < scoreCount; i++) {
+    __atomic_fetch_add(&tournament->scores[i].gamesWon,
+                       localScores[i].gamesWon, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&tournament->scores[i].gamesPlayed,
+                       localScores[i].gamesPlayed, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&tournament->scores[i].incorrectGuesses,
+                       localScores[i].incorrectGuesses, __ATOMIC_RELAXED);
+  }
+  free(localScores);
+  return NULL;
+}
+
+/**
+ * @brief Totals of one strategy across all difficulties, used for ranking.
+ */
+typedef struct {
+  int strategyIndex;
+  long gamesWon;
+  long incorrectGuesses;
+} TournamentRank;
+
+int compareTournamentRanks(const void *a, const void *b) {
+  const TournamentRank *left = a;
+  const TournamentRank *right = b;
+  if (left->gamesWon != right->gamesWon) {
+    return left->gamesWon < right->gamesWon ? 1 : -1;
+  }
+  if (left->incorrectGuesses != right->incorrectGuesses) {
+    return left->incorrectGuesses > right->incorrectGuesses ? 1 : -1;
+  }
+  return left->strategyIndex - right->strategyIndex;
+}
+
+void printTournamentReport(const Tournament *tournament) {
+  TournamentRank ranks[tournament->strategyCount];
+  for (int s = 0; s < tournament->strategyCount; s++) {
+    ranks[s].strategyIndex = s;
+    ranks[s].gamesWon = 0;
+    ranks[s].incorrectGuesses = 0;
+    for (int d = 0; d < DIFFICULTY_COUNT; d++) {
+      const TournamentScore *score =
+          &tournament->scores[s * DIFFICULTY_COUNT + d];
+      ranks[s].gamesWon += score->gamesWon;
+      ranks[s].incorrectGuesses += score->incorrectGuesses;
+    }
+  }
+  qsort(ranks, tournament->strategyCount, sizeof(TournamentRank),
+        compareTournamentRanks);
+
+  printf("\n--- Tournament Results (%d words per difficulty) ---\n",
+         tournament->wordCount);
+  printf("%-4s %-20s", "Rank", "Strategy");
+  for (int d = 0; d < DIFFICULTY_COUNT; d++) {
+    printf(" %8s", difficultyNames[d]);
+  }
+  printf(" %8s %12s\n", "Total", "Avg. misses");
+
+  long gamesPerStrategy = (long)tournament->wordCount * DIFFICULTY_COUNT;
+  for (int r = 0; r < tournament->strategyCount; r++) {
+    int s = ranks[r].strategyIndex;
+    printf("%-4d %-20s", r + 1, tournament->strategies[s]->name);
+    for (int d = 0; d < DIFFICULTY_COUNT; d++) {
+      const TournamentScore *score =
+          &tournament->scores[s * DIFFICULTY_COUNT + d];
+      printf(" %7.2f%%", 100.0 * score->gamesWon / score->gamesPlayed);
+    }
+    printf(" %7.2f%% %12.2f\n", 100.0 * ranks[r].gamesWon / gamesPerStrategy,
+           (double)ranks[r].incorrectGuesses / gamesPerStrategy);
+  }
+}
+
+/**
+ * @brief Plays every job of a tournament on one thread per online CPU and
+ * prints the ranked report.
+ * @return 0 on success, 1 if the tournament could not run.
+ */
+int playTournament(Tournament *tournament) {
+  tournament->scores = calloc(tournament->strategyCount * DIFFICULTY_COUNT,
+                              sizeof(TournamentScore));
+  if (tournament->scores == NULL) {
+    perror("Memory allocation failed for tournament scores");
+    return 1;
+  }
+
+  long threadCount = sysconf(_SC_NPROCESSORS_ONLN);
+  if (threadCount < 1) {
+    threadCount = 1;
+  }
+  tournament->threadsPerGame = 1; // Every CPU already plays its own games
+  printf("Playing %ld games with %d strategies on %ld threads...\n",
+         tournament->totalJobs, tournament->strategyCount, threadCount);
+
+  pthread_t threads[threadCount];
+  long startedCount = 0;
+  for (; startedCount < threadCount; startedCount++) {
+    if (pthread_create(&threads[startedCount], NULL, tournamentWorker,
+                       tournament) != 0) {
+      fprintf(stderr, "Warning: Could only start %ld tournament threads.\n",
+              startedCount);
+      break;
+    }
+  }
+
+  int workerFailed = startedCount == 0;
+  for (long t = 0; t < startedCount; t++) {
+    void *workerResult = NULL;
+    pthread_join(threads[t], &workerResult);
+    workerFailed |= workerResult != NULL;
+  }
+  if (workerFailed) {
+    fprintf(stderr, "Error: The tournament did not finish. No report.\n");
+  } else {
+    printTournamentReport(tournament);
+  }
+
+  free(tournament->scores);
+  tournament->scores = NULL;
+  return workerFailed;
+}
+
+void closeStrategies(void **handles, int count) {
+  for (int i = 0; i < count; i++) {
+    dlclose(handles[i]);
+  }
+}
+
+/**
+ * @brief Loads every strategy and plays it against every word at each
+ * difficulty, then prints a ranked report.
+ * @param frequencies The words' corpus frequencies, or NULL.
+ * @param strategyPaths Paths of the strategy shared objects.
+ * @return 0 on success, 1 if a strategy could not be loaded or the tournament
+ * could not run.
+ */
+int runTournament(char **wordList, const uint32_t *frequencies, int wordCount,
+                  char **strategyPaths, int strategyCount) {
+  void *handles[strategyCount];
+  const HangmanStrategy *strategies[strategyCount];
+
+  for (int i = 0; i < strategyCount; i++) {
+    const char *path = strategyPaths[i];
+    handles[i] = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (handles[i] == NULL) {
+      fprintf(stderr, "Could not load strategy '%s': %s\n", path, dlerror());
+      closeStrategies(handles, i);
+      return 1;
+    }
+
+    HangmanStrategyEntry entry;
+    *(void **)&entry = dlsym(handles[i], HANGMAN_STRATEGY_SYMBOL);
+    strategies[i] = entry ? entry() : NULL;
+    if (strategies[i] == NULL ||
+        strategies[i]->abiVersion < HANGMAN_STRATEGY_MIN_ABI_VERSION ||
+        strategies[i]->abiVersion > HANGMAN_STRATEGY_ABI_VERSION ||
+        strategies[i]->createGame == NULL || strategies[i]->nextGuess == NULL) {
+      fprintf(stderr,
+              "Strategy '%s' does not export a valid %s (ABI version %d to "
+              "%d).\n",
+              path, HANGMAN_STRATEGY_SYMBOL, HANGMAN_STRATEGY_MIN_ABI_VERSION,
+              HANGMAN_STRATEGY_ABI_VERSION);
+      closeStrategies(handles, i + 1);
+      return 1;
+    }
+  }
+
+  Tournament tournament = {0};
+  tournament.strategies = strategies;
+  tournament.strategyCount = strategyCount;
+  tournament.wordList = wordList;
+  tournament.frequencies = frequencies;
+  tournament.wordCount = wordCount;
+  tournament.totalJobs = (long)strategyCount * DIFFICULTY_COUNT * wordCount;
+
+  int result = playTournament(&tournament);
+  closeStrategies(handles, strategyCount);
+  return result;
+}
+
+/**
+ * @brief Sets up a time-attack round: picks the word and builds its letter
+ * mask and display buffer, so starting the round needs no work.
+ */
+void prepareTimeAttackRound(TimeAttackRound *round, char **wordList,
+                            int wordCount, uint64_t seed, uint64_t gameIndex) {
+  round->secretWord = wordList[gameRandom(seed, gameIndex) % wordCount];
+  round->secretMask = letterMask(round->secretWord);
+  round->hiddenLetters = (int)strlen(round->secretWord);
+  memset(round->displayWord, '_', round->hiddenLetters);
+  round->displayWord[round->hiddenLetters] = '\0';
+}
+
+/**
+ * @brief Milliseconds left until deadline on the monotonic clock (0 if past).
+ */
+long millisecondsUntil(const struct timespec *deadline) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  long remaining = (deadline->tv_sec - now.tv_sec) * 1000 +
+                   (deadline->tv_nsec - now.tv_nsec) / 1000000;
+  return remaining > 0 ? remaining : 0;
+}
+
+/**
+ * @brief Plays rounds back to back for TIME_ATTACK_SECONDS at medium
+ * difficulty, with no prompts between rounds.
+ *
+ * The next round is prepared as soon as the current one starts, while the
+ * player is thinking, so moving on to it is immediate. Input waits are bounded
+ * by the time left, so the clock stops the game even mid-guess.
+ *
+ * @return The number of words solved.
+ */
+int playTimeAttack(char **wordList, int wordCount, uint64_t seed) {
+  TimeAttackRound rounds[2];
+  int current = 0;
+  uint64_t gameIndex = 0;
+  int wordsSolved = 0;
+  int wordsMissed = 0;
+
+  // Unbuffered, so poll() on the descriptor sees every pending line
+  setvbuf(stdin, NULL, _IONBF, 0);
+
+  struct timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += TIME_ATTACK_SECONDS;
+
+  printf("\n--- TIME ATTACK: %d seconds, %d incorrect guesses per word ---\n",
+         TIME_ATTACK_SECONDS, MEDIUM_GUESSES);
+  prepareTimeAttackRound(&rounds[current], wordList, wordCount, seed,
+                         gameIndex++);
+
+  int timeUp = 0;
+  while (!timeUp) {
+    TimeAttackRound *round = &rounds[current];
+    prepareTimeAttackRound(&rounds[!current], wordList, wordCount, seed,
+                           gameIndex++);
+
+    char guessedLetters[ALPHABET_SIZE + 1] = {0};
+    int numGuessedLetters = 0;
+    int incorrectGuesses = 0;
+
+    while (round->hiddenLetters > 0 && incorrectGuesses < MEDIUM_GUESSES) {
+      drawHangman(incorrectGuesses);
+      printf("Word: ");
+      for (const char *c = round->displayWord; *c != '\0'; c++) {
+        printf("%c ", *c);
+      }
+      printf("\nGuessed letters: %s\n", guessedLetters);
+      printf("Solved: %d | Time left: %lds | Your guess: ", wordsSolved,
+             (millisecondsUntil(&deadline) + 999) / 1000);
+      fflush(stdout);
+
+      struct pollfd input = {STDIN_FILENO, POLLIN, 0};
+      if (poll(&input, 1, (int)millisecondsUntil(&deadline)) <= 0) {
+        timeUp = 1;
+        break;
+      }
+      char inputBuffer[INPUT_BUFFER_SIZE];
+      if (fgets(inputBuffer, sizeof(inputBuffer), stdin) == NULL) {
+        printf("\nEOF detected on input. Ending time attack.\n");
+        timeUp = 1;
+        break;
+      }
+      if (strchr(inputBuffer, '\n') == NULL) {
+        consumeRemainingInput();
+      }
+
+      char currentGuess = tolower((unsigned char)inputBuffer[0]);
+      if (strlen(inputBuffer) != 2 || !isalpha((unsigned char)currentGuess)) {
+        printf("-> Enter exactly one letter (a-z).\n");
+        continue;
+      }
+      if (strchr(guessedLetters, currentGuess) != NULL) {
+        printf("-> You already guessed '%c'.\n", currentGuess);
+        continue;
+      }
+      guessedLetters[numGuessedLetters++] = currentGuess;
+
+      if (round->secretMask != NOT_SPELLABLE &&
+          !(round->secretMask & (1u << (currentGuess - 'a')))) {
+        incorrectGuesses++;
+      } else {
+        int revealed =
+            revealLetter(round->secretWord, round->displayWord, currentGuess);
+        incorrectGuesses += revealed == 0;
+        round->hiddenLetters -= revealed;
+      }
+    }
+
+    if (round->hiddenLetters == 0) {
+      wordsSolved++;
+      printf("\n-> Solved: %s\n", round->secretWord);
+    } else {
+      wordsMissed++;
+      printf("\n-> %s The word was: %s\n", timeUp ? "Time's up!" : "Missed!",
+             round->secretWord);
+    }
+    current = !current;
+    if (millisecondsUntil(&deadline) == 0) {
+      timeUp = 1;
+    }
+  }
+
+  printf("\n--- Time Attack Over ---\n");
+  printf("Words solved: %d, words missed: %d\n", wordsSolved, wordsMissed);
+  return wordsSolved;
+}
+
+int main(int argc, char *argv[]) {
+  uint64_t seed = (uint64_t)time(NULL);
+  const char *wordFile = "words.txt";
+  const char *extraWordFiles[argc]; // Further --words files, merged in
+  int extraWordFileCount = 0;
+  int wordFileGiven = 0;
+  char **strategyPaths = NULL;
+  int strategyCount = 0;
+  int bonusMode = 0;
+  int timeAttackMode = 0;
+  int followMode = 0;
+  int anagramMode = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--words") == 0 && i + 1 < argc) {
+      if (wordFileGiven) {
+        extraWordFiles[extraWordFileCount++] = argv[++i];
+      } else {
+        wordFile = argv[++i];
+        wordFileGiven = 1;
+      }
+    } else if (strcmp(argv[i], "--bonus") == 0) {
+      bonusMode = 1;
+    } else if (strcmp(argv[i], "--time-attack") == 0) {
+      timeAttackMode = 1;
+    } else if (strcmp(argv[i], "--follow") == 0) {
+      followMode = 1;
+    } else if (strcmp(argv[i], "--anagrams") == 0) {
+      anagramMode = 1;
+    } else if (strcmp(argv[i], "--tournament") == 0 && i + 1 < argc) {
+      // Every remaining argument is a strategy
+      strategyPaths = &argv[i + 1];
+      strategyCount = argc - i - 1;
+      break;
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--words FILE]... [--seed N] [--bonus] [--time-attack] "
+              "[--follow] [--anagrams] [--tournament STRATEGY.so...]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+
   // Program logic will go here in later steps.
   printf("Welcome to Hangman!\n"); // Simple message
 
   // Placeholder call to loadWords (will be refined in Task 20)
   int loadedWordCount = 0;
-  char **wordList = loadWords("words.txt", &loadedWordCount);
+  char **wordList = NULL;
+  WordFollower follower = {wordFile, 0, 0};
+  WordFrequencies frequencies = {NULL, 0}; // Only strategies use them
+  if (followMode) {
+    if (followWords(&follower, &wordList, &loadedWordCount) == -1) {
+      freeWordList(wordList, loadedWordCount);
+      wordList = NULL;
+    }
+  } else {
+    wordList = loadWeightedWords(wordFile, &loadedWordCount,
+                                 strategyCount > 0 ? &frequencies : NULL);
+  }
+  if (extraWordFileCount > 0) {
+    free(frequencies.counts); // Weights are kept for a single word file only
+    frequencies.counts = NULL;
+  }
+
+  WordSet mergedWords = {NULL, 0, 0}; // Kept to merge followed words too
+  for (int f = 0; f < extraWordFileCount && wordList != NULL; f++) {
+    int extraCount = 0;
+    char **extra = loadWords(extraWordFiles[f], &extraCount);
+    if (extra == NULL ||
+        mergeWords(&mergedWords, &wordList, &loadedWordCount, extra,
+                   extraCount) == -1) {
+      freeWordList(wordList, loadedWordCount);
+      wordList = NULL;
+    }
+    follower.capacity = loadedWordCount; // The merge resized the list
+  }
+  if (!followMode) {
+    free(mergedWords.slots); // No more words will arrive
+    mergedWords.slots = NULL;
+  }
 
   // Placeholder check (will be refined in Task 21)
   if (wordList == NULL) {
     fprintf(stderr, "Error loading words from file.\n");
+    free(frequencies.counts);
+    free(mergedWords.slots);
     return 1;
   }
   if (loadedWordCount <= 0) {
     fprintf(stderr, "Error: No words were loaded (%d). Cannot start game.\\n",
             loadedWordCount);
     // Even if wordListMain isn't NULL in some strange case, we need to free it.
+    free(frequencies.counts);
+    free(mergedWords.slots);
     freeWordList(wordList, loadedWordCount); // Use the cleanup function
     return 1;                                // Indicate failure
   }
   // If we reach here, loading was successful!
+  if (strategyCount > 0) {
+    int result = runTournament(wordList, frequencies.counts, loadedWordCount,
+                               strategyPaths, strategyCount);
+    freeWordList(wordList, loadedWordCount);
+    free(frequencies.counts);
+    free(mergedWords.slots);
+    return result;
+  }
+  if (timeAttackMode) {
+    playTimeAttack(wordList, loadedWordCount, seed);
+    freeWordList(wordList, loadedWordCount);
+    free(mergedWords.slots);
+    return 0;
+  }
+  RoundArena roundArena;
+  if (!initRoundArena(&roundArena, ROUND_ARENA_SIZE)) {
+    freeWordList(wordList, loadedWordCount);
+    free(mergedWords.slots);
+    return 1;
+  }
+  AnagramIndex anagramIndex = {NULL, 0, 0, NULL, 0, 0};
+  if (anagramMode &&
+      !buildAnagramIndex(&anagramIndex, wordList, loadedWordCount)) {
+    freeRoundArena(&roundArena);
+    freeWordList(wordList, loadedWordCount);
+    free(mergedWords.slots);
+    return 1;
+  }
+  LazyIndex bonusIndex;
+  lazyIndexInit(&bonusIndex, buildSubsetIndexLazily, destroySubsetIndex);
+  LazyIndex spellIndex; // For whole-word guesses
+  lazyIndexInit(&spellIndex, buildSpellIndexLazily, destroySpellIndex);
   printf("Word list loaded successfully. Ready to play!\n\n");
 
   char playAgain = 'y';
   int maxIncorrectGuesses = MEDIUM_GUESSES;
+  uint64_t gameIndex = 0;
   do {
+    resetRoundArena(&roundArena); // Frees the last round's allocations
+    if (followMode) {
+      int added = followWords(&follower, &wordList, &loadedWordCount);
+      if (added > 0 && mergedWords.slots != NULL) {
+        // Words the other --words files already gave are not added again
+        int dropped = dropKnownWords(&mergedWords, wordList, &loadedWordCount);
+        added -= dropped > 0 ? dropped : 0;
+      }
+      if (added > 0) {
+        printf("\n-> %d new words added (%d total).\n", added,
+               loadedWordCount);
+      }
+    }
+    while (anagramMode && anagramIndex.wordCount < loadedWordCount) {
+      if (!addToAnagramIndex(&anagramIndex, wordList)) {
+        perror("Memory allocation failed for anagram index");
+        anagramMode = 0; // Play on without it
+      }
+    }
+
+    if (bonusMode) {
+      // Built while the round is played; needed only when it ends
+      lazyIndexStart(&bonusIndex, wordList, loadedWordCount);
+    }
+    // Built while the player picks a difficulty; needed for whole-word guesses
+    lazyIndexStart(&spellIndex, wordList, loadedWordCount);
 
     printf("\n--- Select Difficulty ---\n");
     printf("1. Easy   (8 incorrect guesses)\n");
@@ -357,7 +3062,7 @@ int main() {
     }
     pauseForUser();
 
-    int randomIndex = rand() % loadedWordCount;
+    int randomIndex = gameRandom(seed, gameIndex++) % loadedWordCount;
     char *secretWord = wordList[randomIndex];
     printf("DEBUG: Random word selected: %s\n", secretWord);
     printf("DEBUG: Maximum incorrect guesses allowed: %d\n",
@@ -365,7 +3070,11 @@ int main() {
 
     int incorrectGuesses = 0;
     size_t wordLength = strlen(secretWord);
-    char displayWord[wordLength + 1];
+    char *displayWord = roundArenaAlloc(&roundArena, wordLength + 1);
+    if (displayWord == NULL) {
+      playAgain = 'n';
+      continue;
+    }
     for (size_t j = 0; j < wordLength; j++) {
       displayWord[j] = '_';
     }
@@ -395,8 +3104,8 @@ int main() {
       printf("Incorrect guesses remaining: %d\n", guessesRemaining);
       printf("Guessed letters: %s\n", guessedLetters);
 
-      printf("Enter your guess (a single letter): ");
-      char inputBuffer[INPUT_BUFFER_SIZE]; // Buffer to hold the raw input line
+      printf("Enter your guess (a letter, or the whole word): ");
+      char inputBuffer[GUESS_BUFFER_SIZE]; // Buffer to hold the raw input line
       char currentGuess = '\0';            // Initialize guess character
 
       // Read a line from standard input (keyboard)
@@ -415,10 +3124,33 @@ int main() {
         continue;     // Skip the rest of this loop iteration
       }
 
-      if (strlen(inputBuffer) != 2) {
+      size_t guessLength = strspn(inputBuffer, "abcdefghijklmnopqrstuvwxyz"
+                                               "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+      if (guessLength > 1 && strcmp(&inputBuffer[guessLength], "\n") == 0) {
+        inputBuffer[guessLength] = '\0';
+        copyLowercase(inputBuffer, inputBuffer, guessLength);
+        int result = checkWordGuess(&spellIndex, wordList, loadedWordCount,
+                                    secretWord, inputBuffer);
+        if (result == WORD_GUESS_CORRECT) {
+          strcpy(displayWord, secretWord);
+          gameOver = 1;
+          playerWon = 1;
+        } else if (result == WORD_GUESS_WRONG) {
+          printf("\n-> '%s' is not the word.\n", inputBuffer);
+          incorrectGuesses++;
+          gameOver = incorrectGuesses == maxIncorrectGuesses;
+          pauseForUser();
+        } else {
+          pauseForUser(); // Misspelled: no penalty, try again
+        }
+        continue;
+      } else if (strlen(inputBuffer) != 2) {
+        if (strchr(inputBuffer, '\n') == NULL) {
+          consumeRemainingInput();
+        }
         printf(
-            "Invalid input format. Please enter exactly one letter and press "
-            "Enter.\n");
+            "Invalid input format. Please enter one letter, or the whole "
+            "word, and press Enter.\n");
         pauseForUser();
         continue;
       } else {
@@ -442,17 +3174,11 @@ int main() {
         numGuessedLetters++;
         guessedLetters[numGuessedLetters] = '\0';
 
-        int correctGuess = 0;
         printf("\n-> Processing new guess '%c'...\n", currentGuess);
         printf("    -> Checking '%c' against secret word '%s'...\n",
                currentGuess,
                secretWord); // Debug
-        for (size_t i = 0; i < wordLength; i++) {
-          if (secretWord[i] == currentGuess) {
-            displayWord[i] = currentGuess;
-            correctGuess = 1;
-          }
-        }
+        int correctGuess = revealLetter(secretWord, displayWord, currentGuess);
 
         if (!correctGuess) {
           printf(
@@ -484,9 +3210,16 @@ int main() {
     // Check playerWon flag (from Step 8) to display final message
     if (playerWon) {
       printf("Congratulations! You guessed the word: %s\n", secretWord);
+      if (anagramMode) {
+        playAnagramRound(&anagramIndex, wordList, secretWord, &roundArena);
+      }
     } else {
       printf("Sorry, you ran out of guesses. The word was: %s\n", secretWord);
     }
+    if (bonusMode) {
+      printBonusWords(&bonusIndex, wordList, loadedWordCount, guessedLetters,
+                      &roundArena);
+    }
 
     printf("\nPlay Again? (y/n): ");
     char responseBuffer[INPUT_BUFFER_SIZE];
@@ -507,7 +3240,12 @@ int main() {
   } while (playAgain == 'y');
   // --- Memory cleanup ---
   printf("\nCleaning up allocated memory...\n");
+  lazyIndexFree(&bonusIndex);
+  lazyIndexFree(&spellIndex);
+  freeAnagramIndex(&anagramIndex);
+  freeRoundArena(&roundArena);
   freeWordList(wordList, loadedWordCount);
+  free(mergedWords.slots);
   printf("\nGame Over. Thanks for playing!\n");
   return 0;
 }
@@ -0,0 +1,81 @@
+#ifndef HANGMAN_STRATEGY_H
+#define HANGMAN_STRATEGY_H
+
+/*
+ * Stable C ABI for guessing strategies ("bots").
+ *
+ * A strategy is a shared object that exports one function,
+ * HANGMAN_STRATEGY_SYMBOL, returning a pointer to a static HangmanStrategy.
+ * The game loads it with dlopen and checks abiVersion before using it.
+ *
+ * The tournament plays many games at once from several threads. Each game
+ * gets its own state from createGame, and calls for one game never overlap,
+ * but calls for different games may run concurrently.
+ *
+ * A strategy may start threads of its own within nextGuess, up to
+ * HangmanTurn.maxThreads counting the calling thread, and must join them
+ * before it returns. The tournament already runs one game per CPU, so it
+ * passes 1; a caller with a single large query can pass more.
+ *
+ * Build a strategy with:
+ *   gcc -O2 -shared -fPIC -o mybot.so mybot.c
+ */
+
+#define HANGMAN_STRATEGY_ABI_VERSION 3
+// Oldest version the game still loads. Version 1 has no createWeightedGame;
+// versions before 3 ignore HangmanTurn.maxThreads.
+#define HANGMAN_STRATEGY_MIN_ABI_VERSION 1
+#define HANGMAN_STRATEGY_SYMBOL "hangmanStrategy"
+
+/**
+ * @brief What a strategy can see on each turn.
+ */
+typedef struct HangmanTurn {
+  const char *pattern;        // Revealed word, '_' for hidden letters
+  const char *guessedLetters; // Letters guessed so far, in guess order
+  int incorrectGuesses;       // Incorrect guesses made so far
+  int maxIncorrectGuesses;    // The game is lost when this many are made
+  int maxThreads; // Threads nextGuess may use, including the caller (ABI 3)
+} HangmanTurn;
+
+typedef struct HangmanStrategy {
+  unsigned int abiVersion; // HANGMAN_STRATEGY_ABI_VERSION when built
+  const char *name;        // Shown in the tournament report
+
+  /**
+   * @brief Creates the state for one game. May return NULL if the strategy
+   * needs no state.
+   * @param wordList The dictionary the secret word was drawn from. It stays
+   * valid and unchanged until destroyGame is called.
+   * @param wordCount The number of words in wordList.
+   * @param wordLength The length of the secret word.
+   */
+  void *(*createGame)(const char *const *wordList, int wordCount,
+                      int wordLength);
+
+  /**
+   * @brief Returns the next letter to guess (a-z). Repeated or invalid guesses
+   * count as incorrect.
+   */
+  char (*nextGuess)(void *game, const HangmanTurn *turn);
+
+  /**
+   * @brief Frees the state returned by createGame. May be NULL.
+   */
+  void (*destroyGame)(void *game);
+
+  /**
+   * @brief Like createGame, with how common each word is. Used instead of
+   * createGame when present. May be NULL. (ABI version 2.)
+   * @param frequencies Corpus frequency of each word, by index in wordList,
+   * from the word file's optional frequency column (1 where it has none).
+   * Valid as long as wordList.
+   */
+  void *(*createWeightedGame)(const char *const *wordList,
+                              const unsigned int *frequencies, int wordCount,
+                              int wordLength);
+} HangmanStrategy;
+
+typedef const HangmanStrategy *(*HangmanStrategyEntry)(void);
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef PACKED_WORD_H
+#define PACKED_WORD_H
+
+/*
+ * Words of up to PACKED_WORD_MAX_LENGTH letters packed as 5-bit symbols into
+ * a uint64_t: lane i (bits 5i..5i+4) holds letter i as 1-26, 0 marks a hidden
+ * letter or the end of the word. The SWAR ("SIMD within a register") helpers
+ * below test all 12 lanes at once with plain integer operations.
+ *
+ * This is for matching speed, not memory: the word list keeps its strings,
+ * and packed copies are made where words are matched, so they add 8 bytes
+ * per word there.
+ */
+
+#include <stdint.h>
+
+#define PACKED_WORD_MAX_LENGTH 12
+#define PACKED_LANE_BITS 5
+#define PACKED_LANE_ONES 0x0084210842108421ull // 1 in every lane
+#define PACKED_LANE_HIGHS 0x0842108421084210ull // Bit 4 of every lane
+#define PACKED_LANE_LOWS 0x07BDEF7BDEF7BDEFull // Bits 0-3 of every lane
+#define PACKED_HIDDEN '_'
+
+/**
+ * @brief Packs a lowercase word, or a reveal pattern where PACKED_HIDDEN marks
+ * hidden letters.
+ * @param packed Receives the packed word.
+ * @return 1 on success, 0 if the word is too long or has other characters.
+ */
+static inline int packWord(const char *word, uint64_t *packed) {
+  uint64_t result = 0;
+  int i = 0;
+  for (; word[i] != '\0'; i++) {
+    if (i == PACKED_WORD_MAX_LENGTH) {
+      return 0;
+    }
+    if (word[i] >= 'a' && word[i] <= 'z') {
+      result |= (uint64_t)(word[i] - 'a' + 1) << (i * PACKED_LANE_BITS);
+    } else if (word[i] != PACKED_HIDDEN) {
+      return 0;
+    }
+  }
+  *packed = result;
+  return 1;
+}
+
+/**
+ * @brief Marks the non-zero lanes: bit 4 of each lane is set if the lane is
+ * not zero. (x & 0xF) + 0xF sets bit 4 when the low bits are non-zero and
+ * never carries into the next lane.
+ */
+static inline uint64_t packedNonZeroLanes(uint64_t packed) {
+  return (((packed & PACKED_LANE_LOWS) + PACKED_LANE_LOWS) | packed) &
+         PACKED_LANE_HIGHS;
+}
+
+/**
+ * @brief Widens lane markers (bit 4 of each lane) to full 5-bit lane masks.
+ */
+static inline uint64_t packedLaneMask(uint64_t laneHighs) {
+  return (laneHighs >> 4) * 0x1F;
+}
+
+/**
+ * @brief Marks (bit 4) every lane holding a letter.
+ */
+static inline uint64_t packedLetterLanes(uint64_t packed, char letter) {
+  uint64_t broadcast = (uint64_t)(letter - 'a' + 1) * PACKED_LANE_ONES;
+  return ~packedNonZeroLanes(packed ^ broadcast) & PACKED_LANE_HIGHS;
+}
+
+/**
+ * @brief Returns the positions of a letter in a packed word, as a bitmask
+ * (bit i = position i).
+ */
+static inline uint32_t packedLetterPositions(uint64_t packed, char letter) {
+  uint64_t lanes = packedLetterLanes(packed, letter);
+  uint32_t positions = 0;
+  while (lanes != 0) {
+    positions |= 1u << (__builtin_ctzll(lanes) / PACKED_LANE_BITS);
+    lanes &= lanes - 1;
+  }
+  return positions;
+}
+
+/**
+ * @brief Checks a packed word against a packed reveal pattern: every revealed
+ * letter must match. Hidden lanes match anything.
+ */
+static inline int packedMatchesPattern(uint64_t packed, uint64_t pattern) {
+  uint64_t revealed = packedLaneMask(packedNonZeroLanes(pattern));
+  return ((packed ^ pattern) & revealed) == 0;
+}
+
+/**
+ * @brief Returns the reveal pattern a word shows after the given letters have
+ * been guessed, with unguessed letters hidden.
+ *
+ * The result is a packed pattern, so it doubles as an exact hash key: two
+ * words give the same key exactly when a player could not yet tell them apart
+ * (for words of equal length).
+ *
+ * @param guessedMask The guessed letters as a bitmask (bit 0 = 'a').
+ */
+static inline uint64_t packedRevealPattern(uint64_t packed,
+                                           uint32_t guessedMask) {
+  uint64_t keep = 0;
+  while (guessedMask != 0) {
+    char letter = 'a' + __builtin_ctz(guessedMask);
+    keep |= packedLetterLanes(packed, letter);
+    guessedMask &= guessedMask - 1;
+  }
+  return packed & packedLaneMask(keep);
+}
+
+#endif
@@ -0,0 +1,8 @@
+// Bayesian variant of the frequency strategy: each candidate word counts with
+// its corpus frequency (the word file's optional second column) as its prior,
+// so the guess is the letter most likely to be in the secret word.
+//
+// Build: gcc -O2 -shared -fPIC -pthread -o bayes.so bayes.c
+
+#define FREQUENCY_PRIOR
+#include "frequency.c"
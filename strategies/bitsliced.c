@@ -0,0 +1,249 @@
+// Bit-sliced version of the frequency strategy: makes the same guesses, but
+// stores the candidates transposed so one 64-bit operation tests 64 words.
+//
+// For each block of 64 candidates there is one 64-bit slice per (position,
+// letter bit), where bit k of the slice is that bit of candidate k's letter,
+// and one presence slice per letter. Matching a letter at a position is five
+// AND/XOR steps for the whole block, and counting the candidates that contain
+// a letter is one AND and a popcount.
+//
+// Build: gcc -O2 -shared -fPIC -o bitsliced.so bitsliced.c
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../hangman_strategy.h"
+
+#define ALPHABET_SIZE 26
+#define LETTER_BITS 5 // Letters are stored as 1 ('a') to 26 ('z')
+#define BLOCK_SIZE 64
+#define MASK_BYTES 4 // Bytes in a word's letter set (uint32_t)
+
+typedef struct {
+  int wordLength;
+  int blockCount;
+  int sliceCount;   // Per block: wordLength * LETTER_BITS + ALPHABET_SIZE
+  uint64_t *slices; // [block * sliceCount + slice]
+  uint64_t *alive;  // Per block, the candidates still possible
+} BitslicedGame;
+
+static uint32_t lettersOf(const char *word) {
+  uint32_t letters = 0;
+  for (const char *c = word; *c != '\0'; c++) {
+    if (*c >= 'a' && *c <= 'z') {
+      letters |= 1u << (*c - 'a');
+    }
+  }
+  return letters;
+}
+
+static int isPlainWord(const char *word, int wordLength) {
+  for (int i = 0; i < wordLength; i++) {
+    if (word[i] < 'a' || word[i] > 'z') {
+      return 0;
+    }
+  }
+  return word[wordLength] == '\0';
+}
+
+/**
+ * @brief Collects bit (0-7) of each of BLOCK_SIZE bytes into one slice: bit k
+ * of the result is the bit of bytes[k].
+ */
+static uint64_t gatherBit(const uint8_t *bytes, int bit) {
+  uint64_t slice = 0;
+#ifdef __SSE2__
+  // Shifting the 16-bit lanes moves the bit to the top of both bytes, where
+  // movemask reads it
+  __m128i count = _mm_cvtsi32_si128(7 - bit);
+  for (int q = 0; q < BLOCK_SIZE / 16; q++) {
+    __m128i v = _mm_loadu_si128((const __m128i *)&bytes[q * 16]);
+    uint64_t mask = (uint16_t)_mm_movemask_epi8(_mm_sll_epi16(v, count));
+    slice |= mask << (q * 16);
+  }
+#else
+  for (int k = 0; k < BLOCK_SIZE; k++) {
+    slice |= (uint64_t)(bytes[k] >> bit & 1) << k;
+  }
+#endif
+  return slice;
+}
+
+/**
+ * @brief Returns a mask of the block's candidates that have letter (0-25) at
+ * position.
+ */
+static uint64_t letterAt(const uint64_t *block, int position, int letter) {
+  const uint64_t *bits = &block[position * LETTER_BITS];
+  uint64_t code = letter + 1;
+  uint64_t match = ~0ull;
+  for (int b = 0; b < LETTER_BITS; b++) {
+    match &= bits[b] ^ ((code >> b & 1) - 1); // bits[b] or ~bits[b]
+  }
+  return match;
+}
+
+/**
+ * @brief Fills a block's slices from its rows (see createGame) and clears the
+ * rows for the next block.
+ */
+static void transposeBlock(BitslicedGame *game, uint8_t *rows, int blockIndex) {
+  int wordLength = game->wordLength;
+  uint64_t *block = &game->slices[(size_t)blockIndex * game->sliceCount];
+  for (int p = 0; p < wordLength; p++) {
+    for (int b = 0; b < LETTER_BITS; b++) {
+      block[p * LETTER_BITS + b] = gatherBit(&rows[p * BLOCK_SIZE], b);
+    }
+  }
+  const uint8_t *maskRows = &rows[wordLength * BLOCK_SIZE];
+  for (int l = 0; l < ALPHABET_SIZE; l++) {
+    block[wordLength * LETTER_BITS + l] =
+        gatherBit(&maskRows[l / 8 * BLOCK_SIZE], l % 8);
+  }
+  memset(rows, 0, (size_t)(wordLength + MASK_BYTES) * BLOCK_SIZE);
+}
+
+static void destroyGame(void *state);
+
+static void *createGame(const char *const *wordList, int wordCount,
+                        int wordLength) {
+  BitslicedGame *game = malloc(sizeof(BitslicedGame));
+  if (game == NULL) {
+    return NULL;
+  }
+  int candidateCount = 0;
+  for (int i = 0; i < wordCount; i++) {
+    candidateCount += isPlainWord(wordList[i], wordLength);
+  }
+  game->wordLength = wordLength;
+  game->blockCount = (candidateCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  game->sliceCount = wordLength * LETTER_BITS + ALPHABET_SIZE;
+  game->slices = calloc((size_t)game->blockCount * game->sliceCount,
+                        sizeof(uint64_t));
+  game->alive = calloc(game->blockCount, sizeof(uint64_t));
+  if (game->slices == NULL || game->alive == NULL) {
+    free(game->slices);
+    free(game->alive);
+    free(game);
+    return NULL;
+  }
+
+  // Each block is gathered byte-wise first, one row of BLOCK_SIZE bytes per
+  // position and per byte of the letter sets, then transposed
+  uint8_t *rows = calloc((size_t)(wordLength + MASK_BYTES) * BLOCK_SIZE, 1);
+  if (rows == NULL) {
+    destroyGame(game);
+    return NULL;
+  }
+  uint8_t *maskRows = &rows[wordLength * BLOCK_SIZE];
+  int candidate = 0;
+  for (int i = 0; i < wordCount; i++) {
+    if (!isPlainWord(wordList[i], wordLength)) {
+      continue;
+    }
+    int k = candidate % BLOCK_SIZE;
+    uint32_t letters = 0;
+    for (int p = 0; p < wordLength; p++) {
+      rows[p * BLOCK_SIZE + k] = wordList[i][p] - 'a' + 1;
+      letters |= 1u << (wordList[i][p] - 'a');
+    }
+    for (int byte = 0; byte < MASK_BYTES; byte++) {
+      maskRows[byte * BLOCK_SIZE + k] = letters >> (byte * 8);
+    }
+    game->alive[candidate / BLOCK_SIZE] |= 1ull << k;
+    candidate++;
+    if (candidate % BLOCK_SIZE == 0 || candidate == candidateCount) {
+      transposeBlock(game, rows, (candidate - 1) / BLOCK_SIZE);
+    }
+  }
+  free(rows);
+  return game;
+}
+
+/**
+ * @brief Removes the candidates that do not fit the turn and counts, for each
+ * letter, the candidates left that contain it.
+ *
+ * A candidate fits when every revealed letter matches, no hidden position
+ * holds a revealed letter, and it contains no letter that was guessed but not
+ * revealed. That is the same test as the frequency strategy's.
+ */
+static void filterCandidates(BitslicedGame *game, const HangmanTurn *turn,
+                             uint32_t guessedMask,
+                             int letterCounts[ALPHABET_SIZE]) {
+  uint32_t revealedMask = lettersOf(turn->pattern);
+  uint32_t missedMask = guessedMask & ~revealedMask;
+  uint32_t openMask = ~guessedMask & ((1u << ALPHABET_SIZE) - 1);
+
+  for (int k = 0; k < game->blockCount; k++) {
+    uint64_t match = game->alive[k];
+    if (match == 0) {
+      continue;
+    }
+    const uint64_t *block = &game->slices[(size_t)k * game->sliceCount];
+    const uint64_t *present = &block[game->wordLength * LETTER_BITS];
+
+    for (uint32_t l = missedMask; l != 0 && match != 0; l &= l - 1) {
+      match &= ~present[__builtin_ctz(l)];
+    }
+    for (int p = 0; p < game->wordLength && match != 0; p++) {
+      char shown = turn->pattern[p];
+      if (shown != '_') {
+        match &= letterAt(block, p, shown - 'a');
+        continue;
+      }
+      for (uint32_t l = revealedMask; l != 0 && match != 0; l &= l - 1) {
+        match &= ~letterAt(block, p, __builtin_ctz(l));
+      }
+    }
+    game->alive[k] = match;
+
+    for (uint32_t l = match != 0 ? openMask : 0; l != 0; l &= l - 1) {
+      int letter = __builtin_ctz(l);
+      letterCounts[letter] += __builtin_popcountll(match & present[letter]);
+    }
+  }
+}
+
+static char nextGuess(void *state, const HangmanTurn *turn) {
+  static const char fallbackOrder[] = "etaoinshrdlcumwfgypbvkjxqz";
+  BitslicedGame *game = state;
+  int letterCounts[ALPHABET_SIZE] = {0};
+  uint32_t guessedMask = lettersOf(turn->guessedLetters);
+
+  if (game != NULL) {
+    filterCandidates(game, turn, guessedMask, letterCounts);
+  }
+
+  char best = '\0';
+  int bestCount = 0;
+  for (const char *c = fallbackOrder; *c != '\0'; c++) {
+    if (guessedMask & (1u << (*c - 'a'))) {
+      continue;
+    }
+    if (best == '\0' || letterCounts[*c - 'a'] > bestCount) {
+      best = *c;
+      bestCount = letterCounts[*c - 'a'];
+    }
+  }
+  return best;
+}
+
+static void destroyGame(void *state) {
+  BitslicedGame *game = state;
+  if (game != NULL) {
+    free(game->slices);
+    free(game->alive);
+    free(game);
+  }
+}
+
+static const HangmanStrategy bitslicedStrategy = {
+    HANGMAN_STRATEGY_ABI_VERSION, "bitsliced", createGame, nextGuess,
+    destroyGame, NULL};
+
+const HangmanStrategy *hangmanStrategy(void) { return &bitslicedStrategy; }
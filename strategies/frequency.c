@@ -0,0 +1,247 @@
+// Example strategy: guesses the unguessed letter that appears in the most
+// dictionary words still consistent with the revealed pattern.
+//
+// Build: gcc -O2 -shared -fPIC -pthread -o frequency.so frequency.c
+//
+// With FREQUENCY_PRIOR defined (see bayes.c) each word counts with its corpus
+// frequency instead of once.
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../hangman_strategy.h"
+#include "../packed_word.h"
+
+#define ALPHABET_SIZE 26
+// Turns with at least this many candidates split the scan across threads, if
+// the caller allows more than one (HangmanTurn.maxThreads)
+#define PARALLEL_SCAN_THRESHOLD 65536
+#define MAX_SCAN_THREADS 8
+
+typedef struct {
+  const char *word;
+  uint64_t packed;  // packWord(word), if the game is packed
+  uint32_t letters; // Set of letters in word (bit 0 = 'a')
+  uint32_t weight;  // Prior weight of the word (1 without frequencies)
+} Candidate;
+
+typedef struct {
+  Candidate *candidates; // Words still possible
+  int candidateCount;
+  int isPacked; // Every candidate is packed
+} FrequencyGame;
+
+static uint32_t lettersOf(const char *word) {
+  uint32_t letters = 0;
+  for (const char *c = word; *c != '\0'; c++) {
+    if (*c >= 'a' && *c <= 'z') {
+      letters |= 1u << (*c - 'a');
+    }
+  }
+  return letters;
+}
+
+static void *createWeightedGame(const char *const *wordList,
+                                const unsigned int *frequencies,
+                                int wordCount, int wordLength) {
+  FrequencyGame *game = malloc(sizeof(FrequencyGame));
+  if (game == NULL) {
+    return NULL;
+  }
+  game->candidates = malloc(wordCount * sizeof(Candidate));
+  game->candidateCount = 0;
+  game->isPacked = wordLength <= PACKED_WORD_MAX_LENGTH;
+  if (game->candidates == NULL) {
+    free(game);
+    return NULL;
+  }
+  for (int i = 0; i < wordCount; i++) {
+    if (strlen(wordList[i]) != (size_t)wordLength) {
+      continue;
+    }
+    Candidate *candidate = &game->candidates[game->candidateCount++];
+    candidate->word = wordList[i];
+    candidate->letters = lettersOf(wordList[i]);
+    candidate->weight = frequencies != NULL ? frequencies[i] : 1;
+    if (game->isPacked && !packWord(wordList[i], &candidate->packed)) {
+      game->isPacked = 0; // Not a plain lowercase word; compare strings
+    }
+  }
+  return game;
+}
+
+static void *createGame(const char *const *wordList, int wordCount,
+                        int wordLength) {
+  return createWeightedGame(wordList, NULL, wordCount, wordLength);
+}
+
+/**
+ * @brief Checks whether a word could still be the secret word: every revealed
+ * letter matches, and no hidden position holds a letter already guessed.
+ */
+static int matchesTurn(const char *word, const HangmanTurn *turn) {
+  for (size_t i = 0; turn->pattern[i] != '\0'; i++) {
+    if (turn->pattern[i] == '_') {
+      if (strchr(turn->guessedLetters, word[i]) != NULL) {
+        return 0;
+      }
+    } else if (turn->pattern[i] != word[i]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/**
+ * @brief One slice of a candidate scan. Survivors are compacted to the start
+ * of the slice and their weights added to letterWeights for each letter they
+ * contain.
+ */
+typedef struct {
+  Candidate *candidates;
+  int begin;
+  int end;
+  int kept;
+  const HangmanTurn *turn;
+  uint64_t pattern;
+  int usePacked;
+  uint32_t guessedMask;
+  uint64_t letterWeights[ALPHABET_SIZE];
+} CandidateScan;
+
+static void *scanCandidates(void *arg) {
+  CandidateScan *scan = arg;
+  int kept = scan->begin;
+  for (int i = scan->begin; i < scan->end; i++) {
+    const Candidate *candidate = &scan->candidates[i];
+    // A candidate survives when it would show exactly the current pattern
+    int matches = scan->usePacked ? packedRevealPattern(candidate->packed,
+                                                        scan->guessedMask) ==
+                                        scan->pattern
+                                  : matchesTurn(candidate->word, scan->turn);
+    if (!matches) {
+      continue;
+    }
+    scan->candidates[kept++] = *candidate;
+
+    for (uint32_t l = candidate->letters & ~scan->guessedMask; l != 0;
+         l &= l - 1) {
+      scan->letterWeights[__builtin_ctz(l)] += candidate->weight;
+    }
+  }
+  scan->kept = kept - scan->begin;
+  return NULL;
+}
+
+/**
+ * @brief Filters the candidates against the turn and weighs letters.
+ *
+ * A letter's weight is the total weight of the candidates containing it, so
+ * it is proportional to the probability that the letter is in the secret
+ * word, given the pattern and the prior.
+ *
+ * Large candidate sets (the first guesses on a huge dictionary) are split into
+ * one slice per thread the turn allows; the slices' survivors and letter
+ * weights are merged afterwards, so the result is the same as a
+ * single-threaded scan.
+ */
+static void filterCandidates(FrequencyGame *game, const HangmanTurn *turn,
+                             uint32_t guessedMask,
+                             uint64_t letterWeights[ALPHABET_SIZE]) {
+  CandidateScan scans[MAX_SCAN_THREADS];
+  pthread_t threads[MAX_SCAN_THREADS];
+  int started[MAX_SCAN_THREADS] = {0};
+
+  int sliceCount = 1;
+  if (game->candidateCount >= PARALLEL_SCAN_THRESHOLD &&
+      turn->maxThreads > 1) {
+    sliceCount = turn->maxThreads > MAX_SCAN_THREADS ? MAX_SCAN_THREADS
+                                                     : turn->maxThreads;
+  }
+
+  uint64_t pattern = 0;
+  int usePacked = game->isPacked && packWord(turn->pattern, &pattern);
+  for (int t = 0; t < sliceCount; t++) {
+    CandidateScan *scan = &scans[t];
+    memset(scan, 0, sizeof(CandidateScan));
+    scan->candidates = game->candidates;
+    scan->begin = (int)((long)game->candidateCount * t / sliceCount);
+    scan->end = (int)((long)game->candidateCount * (t + 1) / sliceCount);
+    scan->turn = turn;
+    scan->pattern = pattern;
+    scan->usePacked = usePacked;
+    scan->guessedMask = guessedMask;
+  }
+
+  // Slice 0 runs on the calling thread; a slice whose thread fails to start
+  // runs there too.
+  for (int t = 1; t < sliceCount; t++) {
+    started[t] = pthread_create(&threads[t], NULL, scanCandidates,
+                                &scans[t]) == 0;
+  }
+  for (int t = 0; t < sliceCount; t++) {
+    if (!started[t]) {
+      scanCandidates(&scans[t]);
+    }
+  }
+
+  int kept = 0;
+  for (int t = 0; t < sliceCount; t++) {
+    if (started[t]) {
+      pthread_join(threads[t], NULL);
+    }
+    memmove(&game->candidates[kept], &game->candidates[scans[t].begin],
+            scans[t].kept * sizeof(Candidate));
+    kept += scans[t].kept;
+    for (int l = 0; l < ALPHABET_SIZE; l++) {
+      letterWeights[l] += scans[t].letterWeights[l];
+    }
+  }
+  game->candidateCount = kept;
+}
+
+static char nextGuess(void *state, const HangmanTurn *turn) {
+  static const char fallbackOrder[] = "etaoinshrdlcumwfgypbvkjxqz";
+  FrequencyGame *game = state;
+  uint64_t letterWeights[ALPHABET_SIZE] = {0};
+  uint32_t guessedMask = lettersOf(turn->guessedLetters);
+
+  if (game != NULL) {
+    filterCandidates(game, turn, guessedMask, letterWeights);
+  }
+
+  char best = '\0';
+  uint64_t bestWeight = 0;
+  for (const char *c = fallbackOrder; *c != '\0'; c++) {
+    if (guessedMask & (1u << (*c - 'a'))) {
+      continue;
+    }
+    if (best == '\0' || letterWeights[*c - 'a'] > bestWeight) {
+      best = *c;
+      bestWeight = letterWeights[*c - 'a'];
+    }
+  }
+  return best;
+}
+
+static void destroyGame(void *state) {
+  FrequencyGame *game = state;
+  if (game != NULL) {
+    free(game->candidates);
+    free(game);
+  }
+}
+
+#ifdef FREQUENCY_PRIOR
+static const HangmanStrategy frequencyStrategy = {
+    HANGMAN_STRATEGY_ABI_VERSION, "bayes", createGame, nextGuess, destroyGame,
+    createWeightedGame};
+#else
+static const HangmanStrategy frequencyStrategy = {
+    HANGMAN_STRATEGY_ABI_VERSION, "frequency", createGame, nextGuess,
+    destroyGame, NULL};
+#endif
+
+const HangmanStrategy *hangmanStrategy(void) { return &frequencyStrategy; }